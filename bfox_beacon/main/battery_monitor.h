@@ -0,0 +1,69 @@
+#ifndef BFOX_BEACON_MAIN_BATTERY_MONITOR_H_
+#define BFOX_BEACON_MAIN_BATTERY_MONITOR_H_
+// ESP32 B-Fox Beacon
+// (C)2025 bekki.jp
+
+#include <esp_adc/adc_cali.h>
+#include <esp_adc/adc_continuous.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace bfox_beacon_system {
+
+/// Battery voltage from the ADC in continuous (DMA) mode.
+///
+/// The ADC samples at its lowest rate through the digital IIR filter; each
+/// DMA frame is averaged in the conversion-done ISR and smoothed again with
+/// a software IIR, so reading the voltage costs no conversion. The
+/// calibration scheme is created once.
+class BatteryMonitor final {
+ public:
+  static constexpr uint32_t kSampleFreqHz = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+  static constexpr uint32_t kFrameSampleNum = 64;  // ~0.1s per DMA frame
+  static constexpr uint32_t kFilterShift = 3;      // software IIR, 1/8
+
+ public:
+  /// divider_ratio: battery voltage / ADC input voltage
+  BatteryMonitor(const adc_channel_t channel, const uint32_t divider_ratio);
+  ~BatteryMonitor();
+
+  /// Start sampling (keeps running until Stop)
+  bool Start();
+  void Stop();
+
+  /// Wait for the first frame after Start
+  bool WaitReady(const uint32_t timeout_ms);
+
+  /// Filtered battery voltage, 0 before the first frame
+  uint32_t GetVoltageMv() const;
+  float GetVoltage() const { return GetVoltageMv() / 1000.0f; }
+
+  /// Estimated state of charge [%] of a single Li-ion / LiPo cell
+  uint8_t GetStateOfCharge() const;
+  uint32_t GetFrameCount() const { return frame_count_.load(); }
+  static uint8_t EstimateStateOfCharge(const uint32_t voltage_mv);
+
+ private:
+  static bool OnConvDone(adc_continuous_handle_t handle,
+                         const adc_continuous_evt_data_t* event_data,
+                         void* user_data);
+
+ private:
+  adc_channel_t channel_;
+  uint32_t divider_ratio_;
+  adc_continuous_handle_t handle_;
+  adc_cali_handle_t cali_handle_;
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED
+  adc_iir_filter_handle_t iir_filter_;
+#endif
+  SemaphoreHandle_t ready_;  // given on the first frame
+  std::atomic<uint32_t> filtered_raw_;  // raw << kFilterShift
+  std::atomic<uint32_t> frame_count_;   // DMA frames averaged
+};
+
+}  // namespace bfox_beacon_system
+
+#endif  // BFOX_BEACON_MAIN_BATTERY_MONITOR_H_
@@ -9,6 +9,7 @@
 #include <esp_sleep.h>
 #include <esp_system.h>
 #include <nvs_flash.h>
+#include <sdkconfig.h>
 
 #include <cstring>
 #include <memory>
@@ -20,6 +21,7 @@
 #include "gpio_control.h"
 #include "ibeacon.h"
 #include "logger.h"
+#include "perf_counters.h"
 #include "util.h"
 #include "version.h"
 #include "xiao_esp32c6_pin.h"
@@ -50,7 +52,16 @@ constexpr uint8_t kBFoxIBeaconProximityUuid[ESP_UUID_LEN_128] = {
     0x54, 0xD9, 0xE2, 0xF2, 0x11, 0x88  // 54D9E2F21188
 };
 
-BFoxBeacon::BFoxBeacon() : voltage_check_task_(), setting_() {}
+// Monitoring LED blink
+constexpr uint32_t kLedBlinkPeriodMs = 2000;
+constexpr uint32_t kLedOnMs = 100;
+
+BFoxBeacon::BFoxBeacon()
+    : event_loop_(),
+      led_on_timer_(&BFoxBeacon::OnLedOn, this),
+      led_off_timer_(&BFoxBeacon::OnLedOff, this),
+      voltage_check_task_(),
+      setting_() {}
 
 BFoxBeacon::~BFoxBeacon() = default;
 
@@ -69,7 +80,8 @@ void BFoxBeacon::Start() {
   if (!voltage_check_task_) {
     esp_deep_sleep_start();
   }
-  voltage_check_task_->Start();
+  voltage_check_task_->StartOn(&event_loop_,
+                               VoltageCheckTask::kCheckIntervalMs);
 
   // Use Ext Antenna
   gpio::InitOutput(xiao_esp32c6_pin::kWifiEnable,
@@ -105,15 +117,25 @@ void BFoxBeacon::Start() {
   // Bluetooth GATT Server
   CreateBLEService();
 
+#if CONFIG_BFOX_BEACON_PERF_CONSOLE
+  perf::StartConsole();
+#endif
+
   ESP_LOGI(TAG, "Activation Complete bfox Beacon System.");
 
-  while (true) {
-    gpio::SetLevel(kMonitoringLedPin, true);
-    util::SleepMillisecond(100);
-    gpio::SetLevel(kMonitoringLedPin, false);
+  // The main task runs the loop: LED, battery check and deferred jobs
+  event_loop_.StartTimer(&led_on_timer_, 0, kLedBlinkPeriodMs);
+  event_loop_.Run();
+}
 
-    util::SleepMillisecond(1900);
-  }
+void BFoxBeacon::OnLedOn(void* const arg) {
+  BFoxBeacon* const self = static_cast<BFoxBeacon*>(arg);
+  gpio::SetLevel(kMonitoringLedPin, true);
+  self->event_loop_.StartTimer(&self->led_off_timer_, kLedOnMs);
+}
+
+void BFoxBeacon::OnLedOff(void* const arg) {
+  gpio::SetLevel(kMonitoringLedPin, false);
 }
 
 static BleBFoxService* g_ble_bfox_service_ptr = nullptr;
@@ -150,4 +172,6 @@ float BFoxBeacon::GetBatteryVoltage() const {
 
 BeaconSettingConstWeakPtr BFoxBeacon::GetSetting() const { return setting_; }
 
+EventLoop* BFoxBeacon::GetEventLoop() { return &event_loop_; }
+
 }  // namespace bfox_beacon_system
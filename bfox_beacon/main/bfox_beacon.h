@@ -9,6 +9,7 @@
 
 #include "beacon_setting.h"
 #include "bfox_beacon_interface.h"
+#include "event_loop.h"
 #include "voltage_check_task.h"
 #include "xiao_esp32c6_pin.h"
 
@@ -28,11 +29,18 @@ class BFoxBeacon final : public BFoxBeaconInterface,
 
   float GetBatteryVoltage() const override;
   BeaconSettingConstWeakPtr GetSetting() const override;
+  EventLoop* GetEventLoop() override;
 
  private:
   void CreateBLEService();
 
+  static void OnLedOn(void* const arg);
+  static void OnLedOff(void* const arg);
+
  private:
+  EventLoop event_loop_;
+  EventLoop::Timer led_on_timer_;
+  EventLoop::Timer led_off_timer_;
   VoltageCheckTaskUniquePtr voltage_check_task_;
   BeaconSettingSharedPtr setting_;
 };
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "beacon_setting.h"
+#include "event_loop.h"
 
 namespace bfox_beacon_system {
 
@@ -16,6 +17,9 @@ class BFoxBeaconInterface {
 
   virtual float GetBatteryVoltage() const = 0;
   virtual BeaconSettingConstWeakPtr GetSetting() const = 0;
+
+  /// Loop run by the main task, for deferred and periodic jobs
+  virtual EventLoop* GetEventLoop() = 0;
 };
 
 using BFoxBeaconInterfaceSharedPtr = std::shared_ptr<BFoxBeaconInterface>;
@@ -7,6 +7,7 @@
 #include <freertos/task.h>
 
 #include "logger.h"
+#include "perf_counters.h"
 
 // NimBLE Includes
 #include "host/ble_hs.h"
@@ -20,6 +21,11 @@ namespace bfox_beacon_system {
 
 BleDevice* BleDevice::this_ = nullptr;
 
+// NimBLE host task
+static perf::Counter connect_counter("gap.connect");
+static perf::Counter disconnect_counter("gap.disconnect");
+static perf::Counter adv_restart_counter("adv.restart");
+
 BleDevice* BleDevice::GetInstance() {
   if (this_ == nullptr) {
     this_ = new BleDevice();
@@ -114,6 +120,7 @@ int BleDevice::GapEvent(struct ble_gap_event* event, void* arg) {
     case BLE_GAP_EVENT_CONNECT:
       ESP_LOGI(TAG, "BLE_GAP_EVENT_CONNECT status: %d",
                event->connect.status);
+      connect_counter.Increment();
       // Connection state changed. Restart advertising to keep iBeacon alive
       // while connected.
       RestartAdvertising();
@@ -122,6 +129,7 @@ int BleDevice::GapEvent(struct ble_gap_event* event, void* arg) {
     case BLE_GAP_EVENT_DISCONNECT:
       ESP_LOGI(TAG, "BLE_GAP_EVENT_DISCONNECT reason: %d",
                event->disconnect.reason);
+      disconnect_counter.Increment();
       RestartAdvertising();
       break;
 
@@ -200,6 +208,7 @@ void BleDevice::StartAdvertising(uint16_t interval_ms) {
 }
 
 void BleDevice::RestartAdvertising() {
+  adv_restart_counter.Increment();
   StartAdvertising(adv_interval_ms_);
 }
 
@@ -5,8 +5,6 @@
 
 #include <esp_sleep.h>
 #include <esp_system.h>
-#include <freertos/FreeRTOS.h>
-#include <freertos/task.h>
 
 #include <algorithm>
 #include <cstring>
@@ -15,6 +13,7 @@
 #include "bfox_beacon.h"
 #include "gpio_control.h"
 #include "logger.h"
+#include "perf_counters.h"
 #include "util.h"
 
 // NimBLE Includes
@@ -40,6 +39,14 @@ static const ble_uuid128_t gatt_svr_chr_setting_uuid =
 static const ble_uuid128_t gatt_svr_chr_sleep_uuid =
     BLE_UUID128_INIT(0xC1, 0x88, 0x0D, 0xA5, 0xBC, 0xBB, 0x30, 0x9A, 0x18, 0x4C, 0x0E, 0x65, 0x7E, 0x6A, 0xF2, 0x0C);
 
+static const ble_uuid128_t gatt_svr_chr_perf_uuid =
+    BLE_UUID128_INIT(0x83, 0xFE, 0x40, 0xF4, 0xF3, 0x72, 0xD0, 0x84, 0xFE, 0x49, 0x7B, 0xAC, 0x5A, 0xFE, 0x83, 0x44);
+
+// NimBLE host task
+static perf::Counter gatt_read_counter("gatt.read");
+static perf::Counter gatt_write_counter("gatt.write");
+static perf::Histogram gatt_access_histogram("gatt.access_us");
+
 BleVoltageCharacteristic::BleVoltageCharacteristic(
     const BFoxBeaconInterfaceWeakPtr bfox_beacon_interface)
     : bfox_beacon_interface_(bfox_beacon_interface) {}
@@ -57,9 +64,13 @@ void BleVoltageCharacteristic::Read(std::vector<uint8_t>* const data) {
   data->insert(data->begin(), payload.begin(), payload.end());
 }
 
+// Delay between saving the setting and restarting
+constexpr uint32_t kRestartDelayMs = 3000;
+
 BleBeaconSettingCharacteristic::BleBeaconSettingCharacteristic(
     const BFoxBeaconInterfaceWeakPtr bfox_beacon_interface)
-    : bfox_beacon_interface_(bfox_beacon_interface) {}
+    : bfox_beacon_interface_(bfox_beacon_interface),
+      restart_timer_(&BleBeaconSettingCharacteristic::OnRestart, nullptr) {}
 
 void BleBeaconSettingCharacteristic::Write(
     const std::vector<uint8_t>* const data) {
@@ -105,16 +116,18 @@ void BleBeaconSettingCharacteristic::Write(
   setting.SetAdvIntervalMs(adv_interval_ms);
   setting.Save();
 
-  // Restart after 3 seconds
-  xTaskCreate(
-      // Lambda expression with no capture
-      [](void* pvParameter) {
-        ESP_LOGI(TAG, "Starting restart task. Waiting for 3 seconds...");
-        vTaskDelay(pdMS_TO_TICKS(3000));
-        ESP_LOGI(TAG, "Restarting now!");
-        esp_restart();  // Restart the system
-      },
-      "restart_task", 2048, nullptr, 1, nullptr);
+  // Restart after 3 seconds, on the main task's event loop
+  BFoxBeaconInterfaceSharedPtr bfox_beacon = bfox_beacon_interface_.lock();
+  if (!bfox_beacon) {
+    return;
+  }
+  ESP_LOGI(TAG, "Restart in %lums", kRestartDelayMs);
+  bfox_beacon->GetEventLoop()->StartTimer(&restart_timer_, kRestartDelayMs);
+}
+
+void BleBeaconSettingCharacteristic::OnRestart(void* const arg) {
+  ESP_LOGI(TAG, "Restarting now!");
+  esp_restart();  // Restart the system
 }
 
 void BleBeaconSettingCharacteristic::Read(std::vector<uint8_t>* const data) {
@@ -173,6 +186,57 @@ void BleDeepSleepCharacteristic::Write(const std::vector<uint8_t>* const data) {
   }
 }
 
+BlePerfCharacteristic::BlePerfCharacteristic() : snapshots_() {
+  for (auto&& snapshot : snapshots_) {
+    snapshot.conn_handle = BLE_HS_CONN_HANDLE_NONE;
+  }
+}
+
+void BlePerfCharacteristic::Read(std::vector<uint8_t>* const data) {
+  char text[kTextMaxLength];
+  const size_t length = perf::Format(text, sizeof(text));
+  data->insert(data->end(), text, text + length);
+}
+
+void BlePerfCharacteristic::Read(const uint16_t conn_handle,
+                                 const size_t chunk_size,
+                                 std::vector<uint8_t>* const data) {
+  // NimBLE asks for the whole value on every request and sends the part at
+  // the requested offset, which is not passed in. The read ends with the
+  // first response shorter than a chunk.
+  Snapshot* const snapshot = FindSnapshot(conn_handle);
+  if (!snapshot->reading) {
+    snapshot->conn_handle = conn_handle;
+    snapshot->served = 0;
+    snapshot->length = perf::Format(snapshot->text, sizeof(snapshot->text));
+  }
+  const size_t sent =
+      std::min(chunk_size, snapshot->length - snapshot->served);
+  snapshot->served += sent;
+  snapshot->reading = (sent == chunk_size);
+  data->insert(data->end(), snapshot->text,
+               snapshot->text + snapshot->length);
+}
+
+BlePerfCharacteristic::Snapshot* BlePerfCharacteristic::FindSnapshot(
+    const uint16_t conn_handle) {
+  for (auto&& snapshot : snapshots_) {
+    if (snapshot.conn_handle == conn_handle) {
+      return &snapshot;
+    }
+  }
+  // A slot left by a finished read or a closed connection
+  for (auto&& snapshot : snapshots_) {
+    if (!snapshot.reading ||
+        ble_gap_conn_find(snapshot.conn_handle, nullptr) != 0) {
+      snapshot.reading = false;
+      return &snapshot;
+    }
+  }
+  snapshots_[0].reading = false;
+  return &snapshots_[0];
+}
+
 // NimBLE static instance pointer for callback access
 static BleBFoxService* g_ble_bfox_service_inst = nullptr;
 
@@ -180,7 +244,8 @@ BleBFoxService::BleBFoxService(
     const BFoxBeaconInterfaceWeakPtr bfox_beacon_interface)
     : voltage_char_(std::make_shared<BleVoltageCharacteristic>(bfox_beacon_interface)),
       setting_char_(std::make_shared<BleBeaconSettingCharacteristic>(bfox_beacon_interface)),
-      sleep_char_(std::make_shared<BleDeepSleepCharacteristic>(bfox_beacon_interface)) {
+      sleep_char_(std::make_shared<BleDeepSleepCharacteristic>(bfox_beacon_interface)),
+      perf_char_(std::make_shared<BlePerfCharacteristic>()) {
   g_ble_bfox_service_inst = this;
 }
 
@@ -195,6 +260,12 @@ int BleBFoxService::GattSvrChrAccessStatic(uint16_t conn_handle, uint16_t attr_h
 
 int BleBFoxService::GattSvrChrAccess(uint16_t conn_handle, uint16_t attr_handle,
                                      struct ble_gatt_access_ctxt* ctxt, void* arg) {
+  perf::ScopedTimer access_timer(&gatt_access_histogram);
+  if (ctxt->op == BLE_GATT_ACCESS_OP_READ_CHR) {
+    gatt_read_counter.Increment();
+  } else if (ctxt->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
+    gatt_write_counter.Increment();
+  }
   const ble_uuid_t* uuid = ctxt->chr->uuid;
 
   if (ble_uuid_cmp(uuid, &gatt_svr_chr_voltage_uuid.u) == 0) {
@@ -229,6 +300,13 @@ int BleBFoxService::GattSvrChrAccess(uint16_t conn_handle, uint16_t attr_handle,
       }
       return rc == 0 ? 0 : BLE_ATT_ERR_INVALID_ATTR_VALUE_LEN;
     }
+  } else if (ble_uuid_cmp(uuid, &gatt_svr_chr_perf_uuid.u) == 0) {
+    if (ctxt->op == BLE_GATT_ACCESS_OP_READ_CHR) {
+      std::vector<uint8_t> data;
+      perf_char_->Read(conn_handle, ble_att_mtu(conn_handle) - 1, &data);
+      int rc = os_mbuf_append(ctxt->om, data.data(), data.size());
+      return rc == 0 ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+    }
   }
 
   return BLE_ATT_ERR_UNLIKELY;
@@ -259,6 +337,12 @@ static const struct ble_gatt_svc_def gatt_svr_svcs[] = {
                 .access_cb = BleBFoxService::GattSvrChrAccessStatic,
                 .flags = BLE_GATT_CHR_F_WRITE,
             },
+            {
+                // Performance Counters Char
+                .uuid = &gatt_svr_chr_perf_uuid.u,
+                .access_cb = BleBFoxService::GattSvrChrAccessStatic,
+                .flags = BLE_GATT_CHR_F_READ,
+            },
             {
                 0, // No more characteristics in this service
             }
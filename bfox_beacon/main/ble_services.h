@@ -3,10 +3,13 @@
 // ESP32 B-Fox Beacon
 // (C)2025 bekki.jp
 
+#include <sdkconfig.h>
+
 #include <memory>
 #include <vector>
 
 #include "bfox_beacon_interface.h"
+#include "event_loop.h"
 
 // Forward declare for NimBLE
 struct ble_gatt_svc_def;
@@ -45,8 +48,12 @@ class BleBeaconSettingCharacteristic final : public BleCharacteristicInterface {
   void Write(const std::vector<uint8_t>* const data) override;
   void Read(std::vector<uint8_t>* const data) override;
 
+ private:
+  static void OnRestart(void* const arg);
+
  private:
   const BFoxBeaconInterfaceWeakPtr bfox_beacon_interface_;
+  EventLoop::Timer restart_timer_;
 };
 
 class BleDeepSleepCharacteristic final : public BleCharacteristicInterface {
@@ -61,6 +68,38 @@ class BleDeepSleepCharacteristic final : public BleCharacteristicInterface {
   const BFoxBeaconInterfaceWeakPtr bfox_beacon_interface_;
 };
 
+/// Performance counters as "name value" text lines (read only).
+/// A long read takes several ATT requests (read blob), each served from the
+/// same per connection snapshot; the next read after it takes a new one.
+class BlePerfCharacteristic final : public BleCharacteristicInterface {
+ public:
+  BlePerfCharacteristic();
+
+  void Write(const std::vector<uint8_t>* const data) override {}
+  /// Current counters, not kept for a read blob
+  void Read(std::vector<uint8_t>* const data) override;
+  /// chunk_size: value bytes per response (ATT MTU - 1)
+  void Read(const uint16_t conn_handle, const size_t chunk_size,
+            std::vector<uint8_t>* const data);
+
+ private:
+  static constexpr size_t kTextMaxLength = 512;  // longest attribute value
+  static constexpr size_t kSnapshotNum = CONFIG_BT_NIMBLE_MAX_CONNECTIONS;
+
+  struct Snapshot {
+    uint16_t conn_handle;
+    bool reading;   // the last response was a full chunk, more will follow
+    size_t served;  // value bytes sent in this read
+    size_t length;
+    char text[kTextMaxLength];
+  };
+
+  Snapshot* FindSnapshot(const uint16_t conn_handle);
+
+ private:
+  Snapshot snapshots_[kSnapshotNum];
+};
+
 class BleBFoxService final {
  public:
   explicit BleBFoxService(
@@ -81,6 +120,7 @@ class BleBFoxService final {
   BleCharacteristicInterfaceSharedPtr voltage_char_;
   BleCharacteristicInterfaceSharedPtr setting_char_;
   BleCharacteristicInterfaceSharedPtr sleep_char_;
+  std::shared_ptr<BlePerfCharacteristic> perf_char_;
 };
 
 }  // namespace bfox_beacon_system
@@ -0,0 +1,212 @@
+// ESP32 B-Fox Beacon
+// (C)2025 bekki.jp
+
+#include "event_loop.h"
+
+#include <esp_timer.h>
+
+#include <algorithm>
+
+#include "logger.h"
+#include "perf_counters.h"
+
+namespace bfox_beacon_system {
+
+// All loops
+static perf::Counter wakeup_counter("loop.wakeup");
+static perf::Histogram job_histogram("loop.job_us");
+
+EventLoop::EventLoop()
+    : queue_(),
+      loop_task_(nullptr),
+      slots_(),
+      current_tick_(GetNowTick()),
+      timer_count_(0) {
+  if (!queue_.Create(kQueueSize)) {
+    ESP_LOGE(TAG, "Creating event loop queue failed");
+  }
+}
+
+EventLoop::~EventLoop() = default;
+
+void EventLoop::Run() {
+  while (true) {
+    RunOnce();
+  }
+}
+
+void EventLoop::RunOnce() {
+  loop_task_ = xTaskGetCurrentTaskHandle();
+
+  const int64_t ticks = GetTicksToNextTimer(GetNowTick());
+  Command command;
+  const bool received =
+      (ticks < 0) ? queue_.ReceiveBlock(&command)
+                  : queue_.ReceiveWait(&command,
+                                       static_cast<int32_t>(ticks * kTickMs));
+  wakeup_counter.Increment();
+  if (received) {
+    Execute(command);
+    // Take what else is queued before the next wait
+    while (queue_.ReceiveNonBlock(&command)) {
+      Execute(command);
+    }
+  }
+  Advance(GetNowTick());
+}
+
+bool EventLoop::Post(Job job, void* const arg) {
+  return Send({.kind = Command::Kind::kPost, .job = job, .arg = arg});
+}
+
+bool EventLoop::PostFromISR(Job job, void* const arg,
+                            BaseType_t* const high_task_awoken) {
+  return queue_.SendFromISR(
+      {.kind = Command::Kind::kPost, .job = job, .arg = arg},
+      high_task_awoken);
+}
+
+bool EventLoop::StartTimer(Timer* const timer, const uint32_t delay_ms,
+                           const uint32_t period_ms) {
+  if (IsLoopTask()) {
+    Arm(timer, delay_ms, period_ms);
+    return true;
+  }
+  return Send({.kind = Command::Kind::kStartTimer,
+               .timer = timer,
+               .delay_ms = delay_ms,
+               .period_ms = period_ms});
+}
+
+bool EventLoop::StopTimer(Timer* const timer) {
+  if (IsLoopTask()) {
+    Disarm(timer);
+    return true;
+  }
+  return Send({.kind = Command::Kind::kStopTimer, .timer = timer});
+}
+
+int64_t EventLoop::GetNowTick() {
+  return esp_timer_get_time() / (1000 * kTickMs);
+}
+
+bool EventLoop::Send(const Command& command) {
+  if (!queue_.Send(command)) {
+    ESP_LOGW(TAG, "Event loop queue full");
+    return false;
+  }
+  return true;
+}
+
+void EventLoop::Execute(const Command& command) {
+  switch (command.kind) {
+    case Command::Kind::kPost: {
+      perf::ScopedTimer job_timer(&job_histogram);
+      command.job(command.arg);
+      break;
+    }
+    case Command::Kind::kStartTimer:
+      Arm(command.timer, command.delay_ms, command.period_ms);
+      break;
+    case Command::Kind::kStopTimer:
+      Disarm(command.timer);
+      break;
+  }
+}
+
+void EventLoop::Arm(Timer* const timer, const uint32_t delay_ms,
+                    const uint32_t period_ms) {
+  Disarm(timer);
+  const int64_t delay_ticks = (delay_ms + kTickMs - 1) / kTickMs;
+  // Never at or before the tick being dispatched, a job re-arming its own
+  // timer with no delay runs again on the next tick
+  timer->due_tick_ = std::max(GetNowTick() + delay_ticks, current_tick_ + 1);
+  timer->period_ticks_ =
+      (period_ms == 0) ? 0 : std::max<uint32_t>(1, period_ms / kTickMs);
+  timer->armed_ = true;
+  Insert(timer);
+}
+
+void EventLoop::Disarm(Timer* const timer) {
+  if (timer->armed_) {
+    Unlink(timer);
+    timer->armed_ = false;
+  }
+}
+
+void EventLoop::Insert(Timer* const timer) {
+  Timer** const slot = &slots_[timer->due_tick_ % kSlotNum];
+  timer->next_ = *slot;
+  *slot = timer;
+  ++timer_count_;
+}
+
+bool EventLoop::Unlink(Timer* const timer) {
+  for (Timer** link = &slots_[timer->due_tick_ % kSlotNum]; *link != nullptr;
+       link = &(*link)->next_) {
+    if (*link == timer) {
+      *link = timer->next_;
+      timer->next_ = nullptr;
+      --timer_count_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void EventLoop::Advance(const int64_t now_tick) {
+  if (now_tick <= current_tick_) {
+    return;
+  }
+  const int64_t from_tick = current_tick_;
+  current_tick_ = now_tick;
+
+  // Visit the slots of the elapsed ticks, each slot once after a long wait
+  const int64_t span =
+      std::min<int64_t>(now_tick - from_tick, static_cast<int64_t>(kSlotNum));
+  for (int64_t tick = from_tick + 1; tick <= from_tick + span; ++tick) {
+    Timer** const slot = &slots_[tick % kSlotNum];
+    // Restart the scan after each job, it may have changed the slot
+    bool fired = true;
+    while (fired) {
+      fired = false;
+      for (Timer* timer = *slot; timer != nullptr; timer = timer->next_) {
+        if (timer->due_tick_ > now_tick) {
+          continue;  // a later revolution
+        }
+        Unlink(timer);
+        if (timer->period_ticks_ != 0) {
+          // Missed periods are skipped, not run in a burst
+          timer->due_tick_ += timer->period_ticks_;
+          if (timer->due_tick_ <= now_tick) {
+            timer->due_tick_ = now_tick + timer->period_ticks_;
+          }
+          Insert(timer);
+        } else {
+          timer->armed_ = false;
+        }
+        {
+          perf::ScopedTimer job_timer(&job_histogram);
+          timer->job_(timer->arg_);
+        }
+        fired = true;
+        break;
+      }
+    }
+  }
+}
+
+int64_t EventLoop::GetTicksToNextTimer(const int64_t now_tick) const {
+  if (timer_count_ == 0) {
+    return -1;
+  }
+  int64_t next_due_tick = INT64_MAX;
+  for (const Timer* slot : slots_) {
+    for (const Timer* timer = slot; timer != nullptr; timer = timer->next_) {
+      next_due_tick = std::min(next_due_tick, timer->due_tick_);
+    }
+  }
+  return std::max<int64_t>(0, next_due_tick - now_tick);
+}
+
+}  // namespace bfox_beacon_system
@@ -0,0 +1,127 @@
+#ifndef BFOX_BEACON_MAIN_EVENT_LOOP_H_
+#define BFOX_BEACON_MAIN_EVENT_LOOP_H_
+// ESP32 B-Fox Beacon
+// (C)2025 bekki.jp
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "message_queue.h"
+
+namespace bfox_beacon_system {
+
+/// Runs periodic and deferred jobs on one task.
+///
+/// Jobs are posted through a FreeRTOS queue, timers sit in a hashed timer
+/// wheel owned by the loop task. The loop blocks until the next timer is due
+/// or a job is posted, so an idle loop costs no wakeups. Jobs must not block.
+class EventLoop final {
+ public:
+  using Job = void (*)(void* arg);
+
+  static constexpr uint32_t kTickMs = 10;  // timer resolution
+  static constexpr size_t kSlotNum = 64;   // 640ms per wheel revolution
+  static constexpr int32_t kQueueSize = 16;
+
+  /// Caller-owned timer. Armed and stopped through the loop; must stay
+  /// alive while armed.
+  class Timer {
+   public:
+    Timer() : Timer(nullptr, nullptr) {}
+    Timer(Job job, void* const arg)
+        : job_(job),
+          arg_(arg),
+          period_ticks_(0),
+          due_tick_(0),
+          next_(nullptr),
+          armed_(false) {}
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+
+   private:
+    friend class EventLoop;
+
+    Job job_;
+    void* arg_;
+    uint32_t period_ticks_;  // 0: one shot
+    int64_t due_tick_;
+    Timer* next_;  // wheel slot list
+    bool armed_;
+  };
+
+ public:
+  EventLoop();
+  ~EventLoop();
+
+  /// Dispatch forever on the calling task
+  [[noreturn]] void Run();
+
+  /// Wait for the next job or due timer and dispatch (loop task only)
+  void RunOnce();
+
+  /// Run job(arg) on the loop task. Any task.
+  bool Post(Job job, void* const arg);
+
+  /// ISR variant, see MessageQueue::SendFromISR for high_task_awoken
+  bool PostFromISR(Job job, void* const arg,
+                   BaseType_t* const high_task_awoken = nullptr);
+
+  /// (Re)arm a timer: first run after delay_ms, then every period_ms
+  /// (0: once). Any task.
+  bool StartTimer(Timer* const timer, const uint32_t delay_ms,
+                  const uint32_t period_ms = 0);
+
+  /// Disarm a timer. Any task.
+  bool StopTimer(Timer* const timer);
+
+  bool IsLoopTask() const {
+    return loop_task_ == xTaskGetCurrentTaskHandle();
+  }
+
+ private:
+  struct Command {
+    enum class Kind : uint8_t {
+      kPost,
+      kStartTimer,
+      kStopTimer,
+    };
+    Kind kind;
+    Job job;
+    void* arg;
+    Timer* timer;
+    uint32_t delay_ms;
+    uint32_t period_ms;
+  };
+
+  static int64_t GetNowTick();
+
+  bool Send(const Command& command);
+  void Execute(const Command& command);
+
+  void Arm(Timer* const timer, const uint32_t delay_ms,
+           const uint32_t period_ms);
+  void Disarm(Timer* const timer);
+  void Insert(Timer* const timer);
+  bool Unlink(Timer* const timer);
+
+  /// Fire every timer due up to now_tick
+  void Advance(const int64_t now_tick);
+
+  /// Ticks until the next due timer, -1 if none is armed
+  int64_t GetTicksToNextTimer(const int64_t now_tick) const;
+
+ private:
+  MessageQueue<Command> queue_;
+  TaskHandle_t loop_task_;  // set by Run / RunOnce
+  Timer* slots_[kSlotNum];
+  int64_t current_tick_;  // last tick advanced to
+  size_t timer_count_;
+};
+
+}  // namespace bfox_beacon_system
+
+#endif  // BFOX_BEACON_MAIN_EVENT_LOOP_H_
@@ -27,9 +27,6 @@ void SetLevel(const gpio_num_t gpio_number, const bool level);
 /// Get GPIO Level (Input)
 bool GetLevel(const gpio_num_t gpio_number);
 
-/// Get ADC Voltage (Input) [mV]
-uint32_t GetAdcVoltage(const int32_t adc_channel_no, const int32_t round = 1);
-
 }  // namespace gpio
 }  // namespace bfox_beacon_system
 
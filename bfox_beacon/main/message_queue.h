@@ -1,79 +1,123 @@
 #ifndef BFOX_BEACON_MAIN_MESSAGE_QUEUE_H_
-#define BFOX__BEACON_MAIN_MESSAGE_QUEUE_H_
+#define BFOX_BEACON_MAIN_MESSAGE_QUEUE_H_
 // ESP32 B-Fox Beacon
 // (C)2025 bekki.jp
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
 
+#include <cstdint>
+
 namespace bfox_beacon_system {
 
+/// FreeRTOS queue: any number of senders and receivers (default)
 template <typename T>
+class QueueBackend {
+ public:
+  QueueBackend() : queue_(nullptr) {}
+
+  bool Create(const int32_t queue_size) {
+    queue_ = xQueueCreate(queue_size, sizeof(T));
+    return queue_ != nullptr;
+  }
+
+  void Destroy() {
+    xQueueReset(queue_);
+    vQueueDelete(queue_);
+    queue_ = nullptr;
+  }
+
+  bool IsCreated() const { return queue_ != nullptr; }
+
+  bool Send(const T& data, const size_t size, const TickType_t wait) {
+    return xQueueSend(queue_, &data, wait) == pdTRUE;
+  }
+
+  bool SendFromISR(const T& data, const size_t size,
+                   BaseType_t* const high_task_awoken) {
+    return xQueueSendFromISR(queue_, &data, high_task_awoken) == pdTRUE;
+  }
+
+  size_t Receive(T* const data, const TickType_t wait) {
+    return (xQueueReceive(queue_, data, wait) == pdTRUE) ? sizeof(T) : 0;
+  }
+
+ private:
+  QueueHandle_t queue_;
+};
+
+/// Typed message passing. The backend is chosen at compile time; the
+/// beacon only needs QueueBackend (the receiver adds task notification and
+/// message buffer backends).
+template <typename T, template <typename> class Backend = QueueBackend>
 class MessageQueue {
  public:
-  MessageQueue() : queue_(nullptr) {}
+  MessageQueue() : backend_() {}
 
   virtual ~MessageQueue() { Destroy(); }
 
   bool Create(const int32_t queue_size = 1) {
-    if (queue_) {
+    if (backend_.IsCreated()) {
       return true;
     }
-    queue_ = xQueueCreate(queue_size, sizeof(T));
-    if (!queue_) {
-      return false;
-    }
-    return true;
+    return backend_.Create(queue_size);
   }
 
   void Destroy() {
-    if (queue_) {
-      xQueueReset(queue_);
-      vQueueDelete(queue_);
-      queue_ = nullptr;
+    if (backend_.IsCreated()) {
+      backend_.Destroy();
     }
   }
 
-  bool ReceiveWait(T* const receive_data, const int32_t max_wait_millisecond) {
-    if (!queue_) {
+  bool ReceiveWait(T* receive_data, const int32_t max_wait_millisecond) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueReceive(queue_, receive_data,
-                         pdMS_TO_TICKS(max_wait_millisecond));
+    return backend_.Receive(receive_data,
+                            pdMS_TO_TICKS(max_wait_millisecond)) != 0;
   }
 
-  bool ReceiveNonBlock(T* const receive_data) {
-    if (!queue_) {
+  bool ReceiveNonBlock(T* receive_data) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueReceive(queue_, receive_data, 0);
+    return backend_.Receive(receive_data, 0) != 0;
   }
 
-  bool ReceiveBlock(T* const receive_data) {
-    if (!queue_) {
+  bool ReceiveBlock(T* receive_data) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueReceive(queue_, receive_data, portMAX_DELAY);
+    return backend_.Receive(receive_data, portMAX_DELAY) != 0;
   }
 
   bool Send(const T& data) {
-    if (!queue_) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueSend(queue_, &data, 0) == pdTRUE;
+    return backend_.Send(data, sizeof(T), 0);
   }
 
-  bool SendFromISR(const T& data) {
-    if (!queue_) {
+  /// Send from an ISR. If a higher priority task was woken the ISR yields
+  /// on exit; pass high_task_awoken to yield yourself instead (e.g. by
+  /// returning it from a driver callback). Returns true if sent.
+  bool SendFromISR(const T& data,
+                   BaseType_t* const high_task_awoken = nullptr) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    BaseType_t high_task_awoken = pdFALSE;
-    xQueueSendFromISR(queue_, &data, &high_task_awoken);
-    return (high_task_awoken == pdTRUE);
+    BaseType_t awoken = pdFALSE;
+    const bool sent = backend_.SendFromISR(data, sizeof(T), &awoken);
+    if (high_task_awoken != nullptr) {
+      *high_task_awoken |= awoken;
+    } else {
+      portYIELD_FROM_ISR(awoken);
+    }
+    return sent;
   }
 
  private:
-  QueueHandle_t queue_;
+  Backend<T> backend_;
 };
 
 }  // namespace bfox_beacon_system
@@ -0,0 +1,111 @@
+#ifndef BFOX_BEACON_MAIN_PERF_COUNTERS_H_
+#define BFOX_BEACON_MAIN_PERF_COUNTERS_H_
+// ESP32 B-Fox Beacon
+// (C)2025 bekki.jp
+
+#include <esp_timer.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace bfox_beacon_system {
+namespace perf {
+
+/// Event counter. Define with static storage duration (namespace scope);
+/// it registers itself, updates are lock-free and never allocate.
+class Counter final {
+ public:
+  explicit Counter(const char* const name);
+
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void Increment(const uint32_t count = 1) {
+    value_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  uint32_t Get() const { return value_.load(std::memory_order_relaxed); }
+  const char* GetName() const { return name_; }
+  const Counter* GetNext() const { return next_; }
+
+ private:
+  friend void Dump();
+
+  const char* name_;
+  std::atomic<uint32_t> value_;
+  uint32_t dumped_value_;  // at the previous Dump, for the rate
+  Counter* next_;
+};
+
+/// Duration histogram [us] with power of two buckets: bucket 0 counts 0us,
+/// bucket i [2^(i-1), 2^i) us, the last one everything above. Same
+/// registration rules as Counter.
+class Histogram final {
+ public:
+  static constexpr size_t kBucketNum = 16;  // last bucket from 16.4ms
+
+  explicit Histogram(const char* const name);
+
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  void Record(const uint32_t value_us);
+
+  const char* GetName() const { return name_; }
+  const Histogram* GetNext() const { return next_; }
+  uint32_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+  uint32_t GetMax() const { return max_.load(std::memory_order_relaxed); }
+  uint32_t GetMean() const;
+  uint32_t GetBucket(const size_t bucket) const {
+    return buckets_[bucket].load(std::memory_order_relaxed);
+  }
+
+  /// Upper bound [us] of the bucket holding the given fraction of values
+  uint32_t GetPercentileBound(const uint32_t per_mille) const;
+
+ private:
+  const char* name_;
+  std::atomic<uint32_t> count_;
+  std::atomic<uint32_t> sum_;  // [us], wraps after ~71 minutes in total
+  std::atomic<uint32_t> max_;
+  std::atomic<uint32_t> buckets_[kBucketNum];
+  Histogram* next_;
+};
+
+/// Records the lifetime of the scope into a histogram
+class ScopedTimer final {
+ public:
+  explicit ScopedTimer(Histogram* const histogram)
+      : histogram_(histogram), start_us_(esp_timer_get_time()) {}
+
+  ~ScopedTimer() {
+    histogram_->Record(static_cast<uint32_t>(esp_timer_get_time() - start_us_));
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  Histogram* histogram_;
+  int64_t start_us_;
+};
+
+const Counter* GetFirstCounter();
+const Histogram* GetFirstHistogram();
+
+/// Print every counter (with its rate since the previous dump) and
+/// histogram to the console
+void Dump();
+
+/// One "name value" line per counter and histogram into buffer, without
+/// allocation. Returns the length, lines that do not fit are left out.
+size_t Format(char* const buffer, const size_t size);
+
+/// Start the serial console with the "perf" command (prints Dump)
+bool StartConsole();
+
+}  // namespace perf
+}  // namespace bfox_beacon_system
+
+#endif  // BFOX_BEACON_MAIN_PERF_COUNTERS_H_
@@ -6,26 +6,80 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include "logger.h"
+
 namespace bfox_beacon_system {
 
+std::mutex Task::registry_mutex_;
+Task* Task::first_task_ = nullptr;
+
 Task::Task() = default;
 
 Task::Task(const std::string& task_name, const int32_t priority,
-           const int core_id)
+           const int core_id, StackType_t* const stack,
+           const uint32_t stack_depth, StaticTask_t* const task_buffer)
     : status_(kReady),
       task_name_(task_name),
       priority_(priority),
-      core_id_(core_id) {}
+      core_id_(core_id),
+      stack_(stack),
+      stack_depth_(stack_depth),
+      task_buffer_(task_buffer),
+      handle_(nullptr),
+      loop_(nullptr),
+      loop_timer_(&Task::LoopUpdate, this),
+      update_interval_ms_(0),
+      next_task_(nullptr) {
+  std::scoped_lock lock(registry_mutex_);
+  next_task_ = first_task_;
+  first_task_ = this;
+}
 
-Task::~Task() { Stop(); }
+Task::Task(const std::string& task_name, const int32_t priority,
+           const int core_id)
+    : Task(task_name, priority, core_id, nullptr, 0, nullptr) {}
+
+Task::~Task() {
+  Stop();
+  std::scoped_lock lock(registry_mutex_);
+  for (Task** task = &first_task_; *task != nullptr;
+       task = &(*task)->next_task_) {
+    if (*task == this) {
+      *task = next_task_;
+      break;
+    }
+  }
+}
 
 void Task::Start() {
   if (status_ != kReady) {
     return;
   }
+  if (stack_ == nullptr) {
+    ESP_LOGE(TAG, "%s has no stack, use StartOn", task_name_.c_str());
+    return;
+  }
   status_ = kRun;
-  xTaskCreatePinnedToCore(this->Listener, task_name_.c_str(), kTaskStackDepth,
-                          this, priority_, nullptr, core_id_);
+  handle_ = xTaskCreateStaticPinnedToCore(this->Listener, task_name_.c_str(),
+                                          stack_depth_, this, priority_,
+                                          stack_, task_buffer_, core_id_);
+}
+
+void Task::StartOn(EventLoop* const loop, const uint32_t update_interval_ms) {
+  if (status_ != kReady) {
+    return;
+  }
+  status_ = kRun;
+  loop_ = loop;
+  update_interval_ms_ = update_interval_ms;
+  loop_->Post(&Task::LoopStart, this);
+}
+
+bool Task::RequestUpdate(const uint32_t delay_ms) {
+  if (loop_ == nullptr || status_ != kRun) {
+    return false;
+  }
+  return loop_->StartTimer(&loop_timer_, delay_ms, update_interval_ms_);
 }
 
 void Task::Stop() {
@@ -33,6 +87,40 @@ void Task::Stop() {
     return;
   }
   status_ = kEnd;
+  if (loop_ != nullptr) {
+    loop_->StopTimer(&loop_timer_);
+  }
+}
+
+void Task::LoopStart(void* const arg) {
+  Task* const task = static_cast<Task*>(arg);
+  task->Initialize();
+  if (task->update_interval_ms_ != 0) {
+    // First Update right away, as Run does
+    task->loop_->StartTimer(&task->loop_timer_, 0, task->update_interval_ms_);
+  }
+}
+
+void Task::LoopUpdate(void* const arg) {
+  Task* const task = static_cast<Task*>(arg);
+  if (task->status_ == kRun) {
+    task->Update();
+  }
+}
+
+void Task::LogStackUsage() {
+  std::scoped_lock lock(registry_mutex_);
+  for (const Task* task = first_task_; task != nullptr;
+       task = task->next_task_) {
+    if (task->status_ != kRun || task->handle_ == nullptr) {
+      continue;
+    }
+    // Least free stack since start [byte]
+    const UBaseType_t free_bytes = uxTaskGetStackHighWaterMark(task->handle_);
+    ESP_LOGI(TAG, "Stack %-18s used:%5lu free:%5u / %lu",
+             task->task_name_.c_str(), task->stack_depth_ - free_bytes,
+             free_bytes, task->stack_depth_);
+  }
 }
 
 void Task::Run() {
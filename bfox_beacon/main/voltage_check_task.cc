@@ -3,41 +3,51 @@
 
 #include "voltage_check_task.h"
 
-#include <esp_adc/adc_oneshot.h>
 #include <esp_sleep.h>
 
 #include <iomanip>
 #include <sstream>
 
-#include "gpio_control.h"
 #include "logger.h"
-#include "util.h"
 
 namespace bfox_beacon_system {
 
 constexpr float kBatteryDischargeLimit = 3.2f;
+constexpr uint32_t kBatteryDividerRatio = 2;  // A0 sees half the battery
+constexpr uint32_t kBatteryReadyTimeoutMs = 500;
 
 VoltageCheckTask::VoltageCheckTask()
-    : Task(kTaskName, kPriority, kCoreId), voltage_(0.0f) {}
-
-void VoltageCheckTask::Initialize() {}
+    : Task(kTaskName, kPriority, kCoreId),
+      battery_monitor_(ADC_CHANNEL_0, kBatteryDividerRatio) {}
+
+void VoltageCheckTask::Initialize() {
+  // Samples in the background from now on
+  if (!battery_monitor_.Start() ||
+      !battery_monitor_.WaitReady(kBatteryReadyTimeoutMs)) {
+    ESP_LOGE(TAG, "Battery monitor not ready");
+  }
+}
 
 void VoltageCheckTask::Update() {
-  static const int32_t kVoltageAdcCheckRound = 10;
-  const uint32_t adc_voltage =
-      gpio::GetAdcVoltage(ADC_CHANNEL_0, kVoltageAdcCheckRound);
-  voltage_ = 2.0f * adc_voltage / 1000.0f;
-  // ESP_LOGI(TAG, "Battery Voltage %4.2fV", voltage_);
-
-  if (voltage_ <= kBatteryDischargeLimit) {
-    ESP_LOGW(TAG, "Battery Voltage is LOW. %4.2fV", voltage_);
+  const float voltage = GetVoltage();
+  ESP_LOGD(TAG, "Battery Voltage %4.2fV (%u%%)", voltage, GetStateOfCharge());
+
+  // 0V: no frame yet, not an empty battery
+  if (0.0f < voltage && voltage <= kBatteryDischargeLimit) {
+    ESP_LOGW(TAG, "Battery Voltage is LOW. %4.2fV", voltage);
     esp_deep_sleep_start();
   }
+  // Runs on the loop task, whose stack is shared by every loop job
+  ESP_LOGD(TAG, "Loop task stack free:%u",
+           uxTaskGetStackHighWaterMark(nullptr));
+}
 
-  static const int32_t kNextCheckMillisecond = 60 * 1000;
-  util::SleepMillisecond(kNextCheckMillisecond);
+float VoltageCheckTask::GetVoltage() const {
+  return battery_monitor_.GetVoltage();
 }
 
-float VoltageCheckTask::GetVoltage() const { return voltage_; }
+uint8_t VoltageCheckTask::GetStateOfCharge() const {
+  return battery_monitor_.GetStateOfCharge();
+}
 
 }  // namespace bfox_beacon_system
@@ -7,15 +7,18 @@
 
 #include <memory>
 
+#include "battery_monitor.h"
 #include "task.h"
 
 namespace bfox_beacon_system {
 
+/// Runs on an EventLoop (StartOn with kCheckIntervalMs)
 class VoltageCheckTask final : public Task {
  public:
   static constexpr const char kTaskName[] = "VoltageCheckTask";
   static constexpr int kPriority = Task::kPriorityLow;
   static constexpr int kCoreId = tskNO_AFFINITY;
+  static constexpr uint32_t kCheckIntervalMs = 60 * 1000;
 
  public:
   VoltageCheckTask();
@@ -25,9 +28,10 @@ class VoltageCheckTask final : public Task {
   void Update() override;
 
   float GetVoltage() const;
+  uint8_t GetStateOfCharge() const;
 
  private:
-  float voltage_;
+  BatteryMonitor battery_monitor_;
 };
 
 using VoltageCheckTaskUniquePtr = std::unique_ptr<VoltageCheckTask>;
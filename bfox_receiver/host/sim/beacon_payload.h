@@ -0,0 +1,78 @@
+#ifndef BFOX_RECEIVER_HOST_SIM_BEACON_PAYLOAD_H_
+#define BFOX_RECEIVER_HOST_SIM_BEACON_PAYLOAD_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Advertising data of the beacon formats ad_parser.h decodes, plus a
+// foreign frame that matches none of them
+
+// Include ----------------------
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ibeacon.h"
+
+namespace bfox_receiver_system {
+namespace sim {
+
+using Payload = std::vector<uint8_t>;
+
+/// Flags + iBeacon manufacturer data, as bfox_beacon advertises it
+inline Payload MakeIBeacon(const uint8_t* const uuid, const uint16_t major,
+                           const uint16_t minor, const int8_t power) {
+  const BleIBeacon ibeacon = CreateIBeaconAttr(uuid, major, minor, power);
+  const uint8_t* const bytes = reinterpret_cast<const uint8_t*>(&ibeacon);
+  return Payload(bytes, bytes + sizeof(ibeacon));
+}
+
+/// Flags + AltBeacon manufacturer data (beacon id: uuid, major, minor)
+inline Payload MakeAltBeacon(const uint8_t* const uuid, const uint16_t major,
+                             const uint16_t minor, const int8_t power) {
+  uint8_t bytes[31] = {0x02, 0x01, 0x06, 27, 0xFF, 0x18, 0x01, 0xBE, 0xAC};
+  std::memcpy(&bytes[9], uuid, 16);
+  bytes[25] = major >> 8;
+  bytes[26] = major & 0xFF;
+  bytes[27] = minor >> 8;
+  bytes[28] = minor & 0xFF;
+  bytes[29] = static_cast<uint8_t>(power);
+  // Reserved byte stays zero
+  return Payload(bytes, bytes + sizeof(bytes));
+}
+
+/// Flags + service UUID + Eddystone-UID service data
+inline Payload MakeEddystoneUid(const uint8_t* const name_space,
+                                const uint8_t* const instance,
+                                const int8_t tx_power_0m) {
+  uint8_t bytes[31] = {0x02, 0x01, 0x06, 0x03, 0x03, 0xAA, 0xFE, 23,
+                       0x16, 0xAA, 0xFE, 0x00,
+                       static_cast<uint8_t>(tx_power_0m)};
+  std::memcpy(&bytes[13], name_space, 10);
+  std::memcpy(&bytes[23], instance, 6);
+  // RFU bytes (2) stay zero
+  return Payload(bytes, bytes + sizeof(bytes));
+}
+
+/// Flags + service UUID + Eddystone-TLM service data
+inline Payload MakeEddystoneTlm(const uint16_t battery_mv,
+                                const int16_t temperature_x256) {
+  const uint16_t temperature = static_cast<uint16_t>(temperature_x256);
+  return Payload{0x02, 0x01, 0x06, 0x03, 0x03, 0xAA, 0xFE, 17, 0x16, 0xAA,
+                 0xFE, 0x20, 0x00, static_cast<uint8_t>(battery_mv >> 8),
+                 static_cast<uint8_t>(battery_mv & 0xFF),
+                 static_cast<uint8_t>(temperature >> 8),
+                 static_cast<uint8_t>(temperature & 0xFF),
+                 0, 0, 0, 1, 0, 0, 0, 1};
+}
+
+/// Not a beacon: flags, a name and vendor data of another company, as a
+/// phone or a tag nearby would send
+inline Payload MakeForeign() {
+  return Payload{0x02, 0x01, 0x1A, 0x05, 0x09, 'T',  'A',  'G',
+                 '1',  0x09, 0xFF, 0x75, 0x00, 0x42, 0x04, 0x01,
+                 0x80, 0x60, 0x2A};
+}
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_HOST_SIM_BEACON_PAYLOAD_H_
@@ -0,0 +1,100 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "gap_script.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace bfox_receiver_system {
+namespace sim {
+
+namespace {
+
+constexpr int kDefaultMeasuredPower = -59;
+
+bool IsInt8(const int value) { return value >= -128 && value <= 127; }
+
+}  // namespace
+
+ble_addr_t MakeBeaconAddress(const uint16_t major, const uint16_t minor) {
+  // Static random: the two most significant bits set
+  ble_addr_t address = {.type = BLE_ADDR_RANDOM,
+                        .val = {static_cast<uint8_t>(minor & 0xFF),
+                                static_cast<uint8_t>(minor >> 8),
+                                static_cast<uint8_t>(major & 0xFF),
+                                static_cast<uint8_t>(major >> 8), 0xF0,
+                                0xC0}};
+  return address;
+}
+
+bool ParseGapScript(std::istream& input, const uint8_t* const uuid,
+                    std::vector<GapScriptEvent>* const events,
+                    std::string* const error) {
+  std::string line;
+  int line_number = 0;
+  while (std::getline(input, line)) {
+    ++line_number;
+    line = line.substr(0, line.find('#'));
+    std::istringstream fields(line);
+    int64_t time_ms = 0;
+    std::string kind;
+    if (!(fields >> time_ms)) {
+      if (line.find_first_not_of(" \t\r") == std::string::npos) {
+        continue;  // blank
+      }
+      *error = "line " + std::to_string(line_number) + ": time expected";
+      return false;
+    }
+
+    GapScriptEvent event = {.time_ms = time_ms};
+    bool valid = false;
+    if ((fields >> kind) && (kind == "ibeacon" || kind == "altbeacon")) {
+      unsigned major = 0;
+      unsigned minor = 0;
+      int rssi = 0;
+      int power = kDefaultMeasuredPower;
+      valid = (fields >> major >> minor >> rssi) && major <= UINT16_MAX &&
+              minor <= UINT16_MAX && IsInt8(rssi);
+      if (valid && !(fields >> power)) {
+        power = kDefaultMeasuredPower;
+      }
+      valid = valid && IsInt8(power);
+      if (valid) {
+        event.address = MakeBeaconAddress(major, minor);
+        event.rssi = static_cast<int8_t>(rssi);
+        event.payload = (kind == "ibeacon")
+                            ? MakeIBeacon(uuid, major, minor, power)
+                            : MakeAltBeacon(uuid, major, minor, power);
+      }
+    } else if (kind == "foreign") {
+      unsigned address = 0;
+      int rssi = 0;
+      valid = (fields >> address >> rssi) && IsInt8(rssi);
+      if (valid) {
+        event.address = {.type = BLE_ADDR_PUBLIC,
+                         .val = {static_cast<uint8_t>(address & 0xFF),
+                                 static_cast<uint8_t>(address >> 8),
+                                 static_cast<uint8_t>(address >> 16), 0x5A,
+                                 0x00, 0x24}};
+        event.rssi = static_cast<int8_t>(rssi);
+        event.payload = MakeForeign();
+      }
+    }
+    if (!valid) {
+      *error = "line " + std::to_string(line_number) + ": bad event";
+      return false;
+    }
+    events->push_back(event);
+  }
+
+  std::stable_sort(events->begin(), events->end(),
+                   [](const GapScriptEvent& a, const GapScriptEvent& b) {
+                     return a.time_ms < b.time_ms;
+                   });
+  return true;
+}
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
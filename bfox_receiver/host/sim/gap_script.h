@@ -0,0 +1,44 @@
+#ifndef BFOX_RECEIVER_HOST_SIM_GAP_SCRIPT_H_
+#define BFOX_RECEIVER_HOST_SIM_GAP_SCRIPT_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Scripted advertisements for the simulated scanner.
+//
+// One advertisement per line, '#' starts a comment:
+//   <time_ms> ibeacon <major> <minor> <rssi> [measured_power]
+//   <time_ms> altbeacon <major> <minor> <rssi> [measured_power]
+//   <time_ms> foreign <address> <rssi>
+// Beacons get a static random address derived from (major, minor).
+
+// Include ----------------------
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "beacon_payload.h"
+#include "host/ble_hs.h"
+
+namespace bfox_receiver_system {
+namespace sim {
+
+struct GapScriptEvent {
+  int64_t time_ms;
+  ble_addr_t address;
+  int8_t rssi;
+  Payload payload;
+};
+
+/// Address a scripted beacon advertises from
+ble_addr_t MakeBeaconAddress(const uint16_t major, const uint16_t minor);
+
+/// Parse a script, events sorted by time. Returns false with the line
+/// number in error on a malformed line.
+bool ParseGapScript(std::istream& input, const uint8_t* const uuid,
+                    std::vector<GapScriptEvent>* const events,
+                    std::string* const error);
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_HOST_SIM_GAP_SCRIPT_H_
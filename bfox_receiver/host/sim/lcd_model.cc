@@ -0,0 +1,109 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "lcd_model.h"
+
+#include <cstring>
+
+#include "i2c_sim.h"
+
+namespace bfox_receiver_system {
+namespace sim {
+
+namespace {
+
+// Control byte: Co (bit7) = 0, RS (bit6) selects instruction / RAM data
+constexpr uint8_t kControlInstruction = 0x00;
+constexpr uint8_t kControlData = 0x40;
+
+constexpr uint8_t kLine1Address = 0x40;
+
+}  // namespace
+
+LcdModel::LcdModel(i2c_master_bus_handle_t bus, const uint16_t address)
+    : address_(address),
+      ddram_(),
+      cgram_(),
+      address_counter_(0),
+      cgram_selected_(false),
+      extended_instruction_(false),
+      stats_() {
+  std::memset(ddram_, ' ', sizeof(ddram_));
+  i2c_sim::SetTransferHandler(
+      bus, [this](const uint16_t device_address, const uint8_t* const data,
+                  const size_t size) {
+        if (device_address == address_) {
+          OnTransfer(data, size);
+        }
+      });
+}
+
+std::string LcdModel::GetLine(const size_t line, const size_t cols) const {
+  if (line >= kLineNum) {
+    return std::string();
+  }
+  return std::string(reinterpret_cast<const char*>(ddram_[line]),
+                     (cols < kLineLength) ? cols : kLineLength);
+}
+
+uint8_t LcdModel::GetGlyphRow(const uint8_t location, const uint8_t row) const {
+  return cgram_[((location & 0x07) << 3) | (row & 0x07)];
+}
+
+void LcdModel::OnTransfer(const uint8_t* const data, const size_t size) {
+  ++stats_.transactions;
+  stats_.bytes += size;
+  if (size < 2) {
+    return;
+  }
+  // The driver sends one control byte (Co = 0), the rest share its RS
+  const uint8_t control = data[0];
+  for (size_t i = 1; i < size; ++i) {
+    if (control == kControlInstruction) {
+      ++stats_.commands;
+      Execute(data[i]);
+    } else if (control == kControlData) {
+      ++stats_.data_bytes;
+      WriteRam(data[i]);
+    }
+  }
+}
+
+void LcdModel::Execute(const uint8_t instruction) {
+  if (instruction & 0x80) {
+    address_counter_ = instruction & 0x7F;
+    cgram_selected_ = false;
+  } else if (instruction & 0x40) {
+    if (!extended_instruction_) {
+      address_counter_ = instruction & 0x3F;
+      cgram_selected_ = true;
+    }  // IS = 1: ICON address / contrast, no RAM effect here
+  } else if (instruction & 0x20) {
+    extended_instruction_ = (instruction & 0x01) != 0;
+  } else if (instruction == 0x01) {
+    std::memset(ddram_, ' ', sizeof(ddram_));
+    address_counter_ = 0;
+    cgram_selected_ = false;
+  } else if ((instruction & 0xFE) == 0x02) {
+    address_counter_ = 0;
+    cgram_selected_ = false;
+  }
+}
+
+void LcdModel::WriteRam(const uint8_t value) {
+  if (cgram_selected_) {
+    cgram_[address_counter_ & 0x3F] = value;
+    address_counter_ = (address_counter_ + 1) & 0x3F;
+    return;
+  }
+  const size_t line = (address_counter_ >= kLine1Address) ? 1 : 0;
+  const size_t column = address_counter_ - line * kLine1Address;
+  if (column < kLineLength) {
+    ddram_[line][column] = value;
+  }
+  ++address_counter_;
+}
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
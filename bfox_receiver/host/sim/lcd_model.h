@@ -0,0 +1,64 @@
+#ifndef BFOX_RECEIVER_HOST_SIM_LCD_MODEL_H_
+#define BFOX_RECEIVER_HOST_SIM_LCD_MODEL_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// ST7032 controller model on a simulated I2C bus: decodes the transfers the
+// driver sends and keeps the DDRAM, so tests read back what the LCD shows.
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "driver/i2c_master.h"
+
+namespace bfox_receiver_system {
+namespace sim {
+
+class LcdModel final {
+ public:
+  static constexpr size_t kLineNum = 2;
+  static constexpr size_t kLineLength = 0x28;  // DDRAM per line
+
+  struct Stats {
+    uint32_t transactions;
+    uint32_t bytes;  // control and payload bytes
+    uint32_t commands;
+    uint32_t data_bytes;
+  };
+
+ public:
+  /// Answers transfers to address on bus
+  LcdModel(i2c_master_bus_handle_t bus, const uint16_t address);
+
+  LcdModel(const LcdModel&) = delete;
+  LcdModel& operator=(const LcdModel&) = delete;
+
+  /// First cols characters of a line
+  std::string GetLine(const size_t line, const size_t cols) const;
+
+  /// CGRAM row pattern (5 LSBs) of a custom character
+  uint8_t GetGlyphRow(const uint8_t location, const uint8_t row) const;
+
+  const Stats& GetStats() const { return stats_; }
+  void ResetStats() { stats_ = {}; }
+
+ private:
+  void OnTransfer(const uint8_t* const data, const size_t size);
+  void Execute(const uint8_t instruction);
+  void WriteRam(const uint8_t value);
+
+ private:
+  uint16_t address_;
+  uint8_t ddram_[kLineNum][kLineLength];
+  uint8_t cgram_[64];
+  uint8_t address_counter_;
+  bool cgram_selected_;
+  bool extended_instruction_;  // IS = 1
+  Stats stats_;
+};
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_HOST_SIM_LCD_MODEL_H_
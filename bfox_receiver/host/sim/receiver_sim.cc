@@ -0,0 +1,121 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "receiver_sim.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "host_stub.h"
+#include "i2c_sim.h"
+#include "nimble_sim.h"
+#include "search_view.h"
+
+namespace bfox_receiver_system {
+namespace sim {
+
+const uint8_t ReceiverSim::kTargetProximityUuid[16] = {
+    0xC6, 0x5B, 0x2C, 0x5D, 0x9E, 0x53, 0x46, 0xEC,
+    0x8B, 0x8E, 0x54, 0xD9, 0xE2, 0xF2, 0x11, 0x88};
+
+ReceiverSim::ReceiverSim(const size_t active_group,
+                         const RssiFilterMode rssi_filter_mode,
+                         const uint16_t beacon_adv_interval_ms)
+    : groups_(MakeGroups(beacon_adv_interval_ms)),
+      loop_(),
+      loop_task_(host_stub::CreateTask("EventLoopTask")),
+      ui_task_(host_stub::CreateTask("UiTask")),
+      task_(groups_.data(), groups_.size(), active_group, rssi_filter_mode),
+      i2c_bus_(i2c_sim::CreateBus(), &i2c_sim::DeleteBus),
+      lcd_model_(i2c_bus_.get(), ST7032::kI2cDefaultAddr),
+      lcd_(),
+      render_count_(0) {}
+
+ReceiverSim::~ReceiverSim() {
+  task_.Stop();
+  nimble_sim::Reset();
+  vTaskDelete(ui_task_);
+  vTaskDelete(loop_task_);
+}
+
+void ReceiverSim::Start() {
+  lcd_.Setup(i2c_bus_.get(), ST7032::kI2cDefaultAddr, search_view::kLcdCols,
+             search_view::kLcdLines);
+  lcd_.SetContrast(40);
+
+  task_.SetViewChangeNotifyTask(ui_task_);
+  task_.StartOn(&loop_, 0);
+  RunUntilMs(host_stub::GetTimeUs() / 1000);  // Initialize
+  nimble_sim::Sync();
+}
+
+void ReceiverSim::RunUntilMs(const int64_t time_ms) {
+  host_stub::ScopedCurrentTask current_task(loop_task_);
+  const int64_t end_us = time_ms * 1000;
+  while (true) {
+    // Stop at the end of the scan phase, the host restarts the scan
+    const int64_t step_us = std::min(end_us, nimble_sim::GetScanEndUs());
+    host_stub::SetIdleLimitUs(step_us);
+    do {
+      loop_.RunOnce();
+    } while (host_stub::GetTimeUs() < step_us);
+    nimble_sim::Poll();
+    if (step_us >= end_us) {
+      break;
+    }
+  }
+}
+
+bool ReceiverSim::Advertise(const ble_addr_t& address, const int8_t rssi,
+                            const Payload& payload) {
+  return nimble_sim::Advertise(address, rssi, payload.data(),
+                               static_cast<uint8_t>(payload.size()));
+}
+
+void ReceiverSim::Replay(const std::vector<GapScriptEvent>& events) {
+  const int64_t start_ms = host_stub::GetTimeUs() / 1000;
+  for (const GapScriptEvent& event : events) {
+    RunUntilMs(start_ms + event.time_ms);
+    Advertise(event.address, event.rssi, event.payload);
+  }
+}
+
+bool ReceiverSim::RenderIfChanged() {
+  host_stub::ScopedCurrentTask current_task(ui_task_);
+  if (ulTaskNotifyTake(pdTRUE, 0) == 0) {
+    return false;
+  }
+
+  // As BFoxReceiver draws search mode
+  BeaconReceiveTask::RankedItems ranked_items;
+  task_.GetRankedItems(&ranked_items);
+  search_view::Frame frame;
+  search_view::Render(ranked_items, &frame);
+  for (uint8_t line = 0; line < search_view::kLcdLines; ++line) {
+    lcd_.SetCursor(0, line);
+    lcd_.Write(frame.rows[line], search_view::kLcdCols);
+  }
+  ++render_count_;
+  return true;
+}
+
+std::string ReceiverSim::GetLcdLine(const size_t line) const {
+  return lcd_model_.GetLine(line, search_view::kLcdCols);
+}
+
+std::vector<BeaconGroup> ReceiverSim::MakeGroups(
+    const uint16_t beacon_adv_interval_ms) {
+  // One group per course, major = course
+  std::vector<BeaconGroup> groups(kCourseNum);
+  for (size_t course = 0; course < kCourseNum; ++course) {
+    std::memcpy(groups[course].proximity_uuid, kTargetProximityUuid,
+                sizeof(kTargetProximityUuid));
+    groups[course].major = static_cast<uint16_t>(course);
+    groups[course].adv_interval_ms = beacon_adv_interval_ms;
+  }
+  return groups;
+}
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
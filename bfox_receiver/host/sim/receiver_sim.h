@@ -0,0 +1,93 @@
+#ifndef BFOX_RECEIVER_HOST_SIM_RECEIVER_SIM_H_
+#define BFOX_RECEIVER_HOST_SIM_RECEIVER_SIM_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Receive path on the host: BeaconReceiveTask on an EventLoop, fed by the
+// simulated scanner, and the search screen drawn to an ST7032 on a
+// simulated I2C bus.
+//
+// Single threaded on the simulated clock. Advertisements run
+// BeaconReceiveTask::GapEvent as the NimBLE host task would; RunUntilMs
+// dispatches the loop task (drain, expiry, scan restarts) up to a time.
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "beacon_receive_task.h"
+#include "event_loop.h"
+#include "gap_script.h"
+#include "lcd_model.h"
+#include "st7032.h"
+
+namespace bfox_receiver_system {
+namespace sim {
+
+class ReceiverSim final {
+ public:
+  /// Same target UUID as the firmware
+  static const uint8_t kTargetProximityUuid[16];
+  static constexpr size_t kCourseNum = 10;
+  static constexpr uint16_t kBeaconAdvIntervalMs = 500;  // as the firmware
+
+ public:
+  explicit ReceiverSim(const size_t active_group = 0,
+                       const RssiFilterMode rssi_filter_mode =
+                           BeaconReceiveTask::kDefaultRssiFilterMode,
+                       const uint16_t beacon_adv_interval_ms =
+                           kBeaconAdvIntervalMs);
+  ~ReceiverSim();
+
+  ReceiverSim(const ReceiverSim&) = delete;
+  ReceiverSim& operator=(const ReceiverSim&) = delete;
+
+  /// Initialize the task, sync the host and start scanning
+  void Start();
+
+  /// Dispatch the loop task until the clock reaches time_ms
+  void RunUntilMs(const int64_t time_ms);
+
+  /// Deliver one advertisement now. Returns true if the scanner reported it
+  /// to the host.
+  bool Advertise(const ble_addr_t& address, const int8_t rssi,
+                 const Payload& payload);
+
+  /// Run the script (times relative to the call), dispatching the loop
+  /// between events
+  void Replay(const std::vector<GapScriptEvent>& events);
+
+  /// Draw the search screen as the UI task does when notified of a view
+  /// change. Returns false if no change was notified.
+  bool RenderIfChanged();
+
+  std::string GetLcdLine(const size_t line) const;
+
+  BeaconReceiveTask& GetTask() { return task_; }
+  ST7032& GetLcd() { return lcd_; }
+  LcdModel& GetLcdModel() { return lcd_model_; }
+  uint32_t GetRenderCount() const { return render_count_; }
+
+ private:
+  static std::vector<BeaconGroup> MakeGroups(
+      const uint16_t beacon_adv_interval_ms);
+
+ private:
+  std::vector<BeaconGroup> groups_;
+  EventLoop loop_;
+  TaskHandle_t loop_task_;
+  TaskHandle_t ui_task_;
+  BeaconReceiveTask task_;
+  // Outlives the devices on it
+  std::unique_ptr<HostI2cBus, void (*)(i2c_master_bus_handle_t)> i2c_bus_;
+  LcdModel lcd_model_;
+  ST7032 lcd_;
+  uint32_t render_count_;
+};
+
+}  // namespace sim
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_HOST_SIM_RECEIVER_SIM_H_
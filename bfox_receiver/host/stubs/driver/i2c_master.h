@@ -0,0 +1,62 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_DRIVER_I2C_MASTER_H_
+#define BFOX_RECEIVER_HOST_STUBS_DRIVER_I2C_MASTER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: i2c_master driver. Transfers complete at once and are
+// handed to the device model registered with i2c_sim.h.
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+struct HostI2cBus;
+struct HostI2cDevice;
+typedef HostI2cBus* i2c_master_bus_handle_t;
+typedef HostI2cDevice* i2c_master_dev_handle_t;
+
+typedef enum {
+  I2C_ADDR_BIT_LEN_7 = 0,
+  I2C_ADDR_BIT_LEN_10 = 1,
+} i2c_addr_bit_len_t;
+
+typedef struct {
+  i2c_addr_bit_len_t dev_addr_length;
+  uint16_t device_address;
+  uint32_t scl_speed_hz;
+} i2c_device_config_t;
+
+typedef enum {
+  I2C_EVENT_ALIVE,
+  I2C_EVENT_DONE,
+  I2C_EVENT_NACK,
+  I2C_EVENT_TIMEOUT,
+} i2c_master_event_t;
+
+typedef struct {
+  i2c_master_event_t event;
+} i2c_master_event_data_t;
+
+typedef bool (*i2c_master_callback_t)(i2c_master_dev_handle_t i2c_dev,
+                                      const i2c_master_event_data_t* evt_data,
+                                      void* arg);
+
+typedef struct {
+  i2c_master_callback_t on_trans_done;
+} i2c_master_event_callbacks_t;
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle,
+                                    const i2c_device_config_t* dev_config,
+                                    i2c_master_dev_handle_t* ret_handle);
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle);
+esp_err_t i2c_master_register_event_callbacks(
+    i2c_master_dev_handle_t i2c_dev, const i2c_master_event_callbacks_t* cbs,
+    void* user_data);
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev,
+                              const uint8_t* write_buffer, size_t write_size,
+                              int xfer_timeout_ms);
+esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t bus_handle,
+                                       int timeout_ms);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_DRIVER_I2C_MASTER_H_
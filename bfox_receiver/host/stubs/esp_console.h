@@ -0,0 +1,37 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_ESP_CONSOLE_H_
+#define BFOX_RECEIVER_HOST_STUBS_ESP_CONSOLE_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: serial console (not supported, no console device is
+// configured in sdkconfig.h)
+
+// Include ----------------------
+#include "esp_err.h"
+
+typedef struct esp_console_repl_s esp_console_repl_t;
+
+typedef struct {
+  uint32_t max_history_len;
+  const char* history_save_path;
+  uint32_t task_stack_size;
+  uint32_t task_priority;
+  const char* prompt;
+  size_t max_cmdline_length;
+} esp_console_repl_config_t;
+
+#define ESP_CONSOLE_REPL_CONFIG_DEFAULT() {}
+
+typedef int (*esp_console_cmd_func_t)(int argc, char** argv);
+
+typedef struct {
+  const char* command;
+  const char* help;
+  const char* hint;
+  esp_console_cmd_func_t func;
+  void* argtable;
+} esp_console_cmd_t;
+
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t* cmd);
+esp_err_t esp_console_start_repl(esp_console_repl_t* repl);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_ESP_CONSOLE_H_
@@ -0,0 +1,31 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_ESP_ERR_H_
+#define BFOX_RECEIVER_HOST_STUBS_ESP_ERR_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: error codes
+
+// Include ----------------------
+#include <cstdint>
+#include <cstdlib>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_NOT_SUPPORTED 0x106
+#define ESP_ERR_TIMEOUT 0x107
+
+const char* esp_err_to_name(esp_err_t code);
+
+#define ESP_ERROR_CHECK(x)      \
+  do {                          \
+    if ((x) != ESP_OK) {        \
+      std::abort();             \
+    }                           \
+  } while (0)
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_ESP_ERR_H_
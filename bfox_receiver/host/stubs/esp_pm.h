@@ -0,0 +1,21 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_ESP_PM_H_
+#define BFOX_RECEIVER_HOST_STUBS_ESP_PM_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: power management (not supported)
+
+// Include ----------------------
+#include <cstdio>
+
+#include "esp_err.h"
+
+typedef struct {
+  int max_freq_mhz;
+  int min_freq_mhz;
+  bool light_sleep_enable;
+} esp_pm_config_t;
+
+esp_err_t esp_pm_configure(const void* config);
+esp_err_t esp_pm_dump_locks(FILE* stream);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_ESP_PM_H_
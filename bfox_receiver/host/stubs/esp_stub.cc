@@ -0,0 +1,121 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: ESP-IDF services used by the receive path
+
+// Include ----------------------
+#include <esp_console.h>
+#include <esp_err.h>
+#include <esp_log.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+#include <esp_vfs_fat.h>
+#include <rom/ets_sys.h>
+
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "host_stub.h"
+#include "util.h"
+
+namespace {
+
+esp_log_level_t LogLevelFromEnvironment() {
+  // BFOX_HOST_LOG=0..5 (esp_log_level_t)
+  const char* const level = std::getenv("BFOX_HOST_LOG");
+  return (level != nullptr) ? static_cast<esp_log_level_t>(std::atoi(level))
+                            : ESP_LOG_WARN;
+}
+
+esp_log_level_t log_level = LogLevelFromEnvironment();
+
+}  // namespace
+
+int64_t esp_timer_get_time() { return host_stub::GetTimeUs(); }
+
+void ets_delay_us(uint32_t us) { host_stub::AdvanceTimeUs(us); }
+
+const char* esp_err_to_name(esp_err_t code) {
+  switch (code) {
+    case ESP_OK:
+      return "ESP_OK";
+    case ESP_FAIL:
+      return "ESP_FAIL";
+    case ESP_ERR_NO_MEM:
+      return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG:
+      return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_STATE:
+      return "ESP_ERR_INVALID_STATE";
+    case ESP_ERR_NOT_FOUND:
+      return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+      return "ESP_ERR_NOT_SUPPORTED";
+    case ESP_ERR_TIMEOUT:
+      return "ESP_ERR_TIMEOUT";
+    default:
+      return "UNKNOWN ERROR";
+  }
+}
+
+void esp_log_level_set(const char* tag, esp_log_level_t level) {
+  if (std::strcmp(tag, "*") == 0) {
+    log_level = level;
+  }
+}
+
+void esp_log_write(esp_log_level_t level, const char* tag, const char* format,
+                   ...) {
+  if (level > log_level) {
+    return;
+  }
+  static constexpr char kLevelLetters[] = "NEWIDV";
+  std::fprintf(stderr, "%c (%" PRId64 ") %s: ", kLevelLetters[level],
+               host_stub::GetTimeUs() / 1000, tag);
+  va_list args;
+  va_start(args, format);
+  std::vfprintf(stderr, format, args);
+  va_end(args);
+  std::fputc('\n', stderr);
+}
+
+esp_err_t esp_pm_configure(const void* config) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_pm_dump_locks(FILE* stream) {
+  std::fprintf(stream, "Lock stats:\nMode stats:\n");
+  return ESP_OK;
+}
+
+esp_err_t esp_console_cmd_register(const esp_console_cmd_t* cmd) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_console_start_repl(esp_console_repl_t* repl) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_vfs_fat_spiflash_mount_rw_wl(
+    const char* base_path, const char* partition_label,
+    const esp_vfs_fat_mount_config_t* mount_config, wl_handle_t* wl_handle) {
+  *wl_handle = WL_INVALID_HANDLE;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t esp_vfs_fat_spiflash_unmount_rw_wl(const char* base_path,
+                                             wl_handle_t wl_handle) {
+  return ESP_OK;
+}
+
+namespace bfox_receiver_system {
+namespace util {
+
+void SleepMillisecond(const uint32_t sleep_milliseconds) {
+  host_stub::AdvanceTimeUs(static_cast<int64_t>(sleep_milliseconds) * 1000);
+}
+
+}  // namespace util
+}  // namespace bfox_receiver_system
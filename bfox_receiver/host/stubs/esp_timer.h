@@ -0,0 +1,12 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_ESP_TIMER_H_
+#define BFOX_RECEIVER_HOST_STUBS_ESP_TIMER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: the simulated clock (host_stub.h) [us]
+
+// Include ----------------------
+#include <cstdint>
+
+int64_t esp_timer_get_time();
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_ESP_TIMER_H_
@@ -0,0 +1,30 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_ESP_VFS_FAT_H_
+#define BFOX_RECEIVER_HOST_STUBS_ESP_VFS_FAT_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: FAT on flash. Mounting fails, so ScanTraceRecorder stays
+// closed; traces are read with tools/scan_trace_replay instead.
+
+// Include ----------------------
+#include <sdkconfig.h>
+
+#include <cstddef>
+
+#include "esp_err.h"
+#include "wear_levelling.h"
+
+typedef struct {
+  bool format_if_mount_failed;
+  int max_files;
+  size_t allocation_unit_size;
+  bool disk_status_check_enable;
+  bool use_one_fat;
+} esp_vfs_fat_mount_config_t;
+
+esp_err_t esp_vfs_fat_spiflash_mount_rw_wl(
+    const char* base_path, const char* partition_label,
+    const esp_vfs_fat_mount_config_t* mount_config, wl_handle_t* wl_handle);
+esp_err_t esp_vfs_fat_spiflash_unmount_rw_wl(const char* base_path,
+                                             wl_handle_t wl_handle);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_ESP_VFS_FAT_H_
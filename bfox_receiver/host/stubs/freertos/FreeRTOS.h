@@ -0,0 +1,36 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_FREERTOS_FREERTOS_H_
+#define BFOX_RECEIVER_HOST_STUBS_FREERTOS_FREERTOS_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: FreeRTOS types and constants (see host_stub.h)
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t StackType_t;  // ESP-IDF: stack depth in bytes
+
+struct StaticTask_t {
+  uint8_t reserved[16];
+};
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 25
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) \
+  ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define tskNO_AFFINITY ((BaseType_t)0x7FFFFFFF)
+
+// Single threaded: an ISR never preempts, nothing to yield to
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_FREERTOS_FREERTOS_H_
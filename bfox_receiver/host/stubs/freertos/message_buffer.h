@@ -0,0 +1,24 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_FREERTOS_MESSAGE_BUFFER_H_
+#define BFOX_RECEIVER_HOST_STUBS_FREERTOS_MESSAGE_BUFFER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: message buffers (each record costs its length plus a
+// size_t, as on target)
+
+// Include ----------------------
+#include "freertos/FreeRTOS.h"
+
+struct HostMessageBuffer;
+typedef HostMessageBuffer* MessageBufferHandle_t;
+
+MessageBufferHandle_t xMessageBufferCreate(size_t buffer_size);
+void vMessageBufferDelete(MessageBufferHandle_t buffer);
+size_t xMessageBufferSend(MessageBufferHandle_t buffer, const void* data,
+                          size_t size, TickType_t wait);
+size_t xMessageBufferSendFromISR(MessageBufferHandle_t buffer,
+                                 const void* data, size_t size,
+                                 BaseType_t* high_task_awoken);
+size_t xMessageBufferReceive(MessageBufferHandle_t buffer, void* data,
+                             size_t size, TickType_t wait);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_FREERTOS_MESSAGE_BUFFER_H_
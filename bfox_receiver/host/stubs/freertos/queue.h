@@ -0,0 +1,24 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_FREERTOS_QUEUE_H_
+#define BFOX_RECEIVER_HOST_STUBS_FREERTOS_QUEUE_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: queues. A receive on an empty queue waits in simulated
+// time (host_stub::Idle) and fails.
+
+// Include ----------------------
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+struct HostQueue;
+typedef HostQueue* QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueReset(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t wait);
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item,
+                             BaseType_t* high_task_awoken);
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_FREERTOS_QUEUE_H_
@@ -0,0 +1,22 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_FREERTOS_SEMPHR_H_
+#define BFOX_RECEIVER_HOST_STUBS_FREERTOS_SEMPHR_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: counting semaphores
+
+// Include ----------------------
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+struct HostSemaphore;
+typedef HostSemaphore* SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count,
+                                           UBaseType_t initial_count);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore,
+                                 BaseType_t* high_task_awoken);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_FREERTOS_SEMPHR_H_
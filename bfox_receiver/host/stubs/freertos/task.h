@@ -0,0 +1,49 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_FREERTOS_TASK_H_
+#define BFOX_RECEIVER_HOST_STUBS_FREERTOS_TASK_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: tasks and task notifications.
+//
+// Nothing runs concurrently. Created tasks are registered but never run;
+// the current task is chosen by the simulation (host_stub::SetCurrentTask).
+
+// Include ----------------------
+#include "freertos/FreeRTOS.h"
+
+struct HostTask;
+typedef HostTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite,
+} eNotifyAction;
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(
+    TaskFunction_t function, const char* name, uint32_t stack_depth,
+    void* param, UBaseType_t priority, StackType_t* stack,
+    StaticTask_t* task_buffer, BaseType_t core_id);
+void vTaskDelete(TaskHandle_t task);
+
+/// Advances the simulated clock
+void vTaskDelay(TickType_t ticks);
+
+/// The whole stack, nothing is used on the host
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t wait);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action);
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value,
+                              eNotifyAction action,
+                              BaseType_t* high_task_awoken);
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t* value, TickType_t wait);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_FREERTOS_TASK_H_
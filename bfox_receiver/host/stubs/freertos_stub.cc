@@ -0,0 +1,314 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: FreeRTOS on a simulated clock, single threaded
+
+// Include ----------------------
+#include <freertos/FreeRTOS.h>
+#include <freertos/message_buffer.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "host_stub.h"
+
+struct HostTask {
+  std::string name;
+  uint32_t stack_depth;
+  uint32_t notify_value;
+  bool notify_pending;
+};
+
+struct HostQueue {
+  size_t length;
+  size_t item_size;
+  std::deque<std::vector<uint8_t>> items;
+};
+
+struct HostSemaphore {
+  UBaseType_t max_count;
+  UBaseType_t count;
+};
+
+struct HostMessageBuffer {
+  size_t buffer_size;
+  size_t used;  // records plus their length words
+  std::deque<std::vector<uint8_t>> records;
+};
+
+namespace {
+
+int64_t time_us = 0;
+int64_t idle_limit_us = INT64_MAX;
+
+HostTask main_task = {.name = "main", .stack_depth = 0};
+TaskHandle_t current_task = &main_task;
+
+int64_t TicksToUs(const TickType_t ticks) {
+  return static_cast<int64_t>(ticks) * 1000000 / configTICK_RATE_HZ;
+}
+
+}  // namespace
+
+namespace host_stub {
+
+int64_t GetTimeUs() { return time_us; }
+
+void SetTimeUs(const int64_t new_time_us) { time_us = new_time_us; }
+
+void AdvanceTimeUs(const int64_t delta_us) { time_us += delta_us; }
+
+void SetIdleLimitUs(const int64_t limit_us) { idle_limit_us = limit_us; }
+
+int64_t GetIdleLimitUs() { return idle_limit_us; }
+
+void Idle(const TickType_t ticks) {
+  if (ticks == 0 || time_us >= idle_limit_us) {
+    return;
+  }
+  if (ticks == portMAX_DELAY || TicksToUs(ticks) >= idle_limit_us - time_us) {
+    time_us = std::max(time_us, idle_limit_us);
+  } else {
+    time_us += TicksToUs(ticks);
+  }
+}
+
+TaskHandle_t CreateTask(const char* const name) {
+  return new HostTask{.name = name, .stack_depth = 0};
+}
+
+void SetCurrentTask(const TaskHandle_t task) {
+  current_task = (task != nullptr) ? task : &main_task;
+}
+
+const char* GetTaskName(const TaskHandle_t task) {
+  return (task != nullptr) ? task->name.c_str() : "";
+}
+
+uint32_t GetNotifyCount(const TaskHandle_t task) {
+  return (task != nullptr) ? task->notify_value : 0;
+}
+
+}  // namespace host_stub
+
+// Tasks ------------------------
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return current_task; }
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(
+    TaskFunction_t function, const char* name, uint32_t stack_depth,
+    void* param, UBaseType_t priority, StackType_t* stack,
+    StaticTask_t* task_buffer, BaseType_t core_id) {
+  TaskHandle_t task = host_stub::CreateTask(name);
+  task->stack_depth = stack_depth;
+  return task;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task != nullptr && task != &main_task) {
+    delete task;
+  }
+}
+
+void vTaskDelay(TickType_t ticks) { time_us += TicksToUs(ticks); }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return (task != nullptr) ? task->stack_depth : 0;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  ++task->notify_value;
+  task->notify_pending = true;
+  return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t wait) {
+  if (current_task->notify_value == 0) {
+    host_stub::Idle(wait);
+    return 0;
+  }
+  const uint32_t value = current_task->notify_value;
+  current_task->notify_value = clear_on_exit ? 0 : value - 1;
+  current_task->notify_pending = false;
+  return value;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action) {
+  switch (action) {
+    case eSetBits:
+      task->notify_value |= value;
+      break;
+    case eIncrement:
+      ++task->notify_value;
+      break;
+    case eSetValueWithOverwrite:
+      task->notify_value = value;
+      break;
+    case eSetValueWithoutOverwrite:
+      if (task->notify_pending) {
+        return pdFAIL;
+      }
+      task->notify_value = value;
+      break;
+    case eNoAction:
+    default:
+      break;
+  }
+  task->notify_pending = true;
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value,
+                              eNotifyAction action,
+                              BaseType_t* high_task_awoken) {
+  const BaseType_t ret = xTaskNotify(task, value, action);
+  if (ret == pdPASS && high_task_awoken != nullptr) {
+    *high_task_awoken = pdTRUE;
+  }
+  return ret;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clear_on_entry, uint32_t clear_on_exit,
+                           uint32_t* value, TickType_t wait) {
+  if (!current_task->notify_pending) {
+    current_task->notify_value &= ~clear_on_entry;
+    host_stub::Idle(wait);
+    return pdFALSE;
+  }
+  if (value != nullptr) {
+    *value = current_task->notify_value;
+  }
+  current_task->notify_value &= ~clear_on_exit;
+  current_task->notify_pending = false;
+  return pdTRUE;
+}
+
+// Queues -----------------------
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+  return new HostQueue{.length = length, .item_size = item_size};
+}
+
+void vQueueDelete(QueueHandle_t queue) { delete queue; }
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+  queue->items.clear();
+  return pdPASS;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t wait) {
+  // Nobody could make room while waiting
+  if (queue->items.size() >= queue->length) {
+    return pdFALSE;
+  }
+  const uint8_t* const bytes = static_cast<const uint8_t*>(item);
+  queue->items.emplace_back(bytes, bytes + queue->item_size);
+  return pdTRUE;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item,
+                             BaseType_t* high_task_awoken) {
+  const BaseType_t ret = xQueueSend(queue, item, 0);
+  if (ret == pdTRUE && high_task_awoken != nullptr) {
+    *high_task_awoken = pdTRUE;
+  }
+  return ret;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t wait) {
+  if (queue->items.empty()) {
+    host_stub::Idle(wait);
+    return pdFALSE;
+  }
+  std::memcpy(item, queue->items.front().data(), queue->item_size);
+  queue->items.pop_front();
+  return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  return queue->items.size();
+}
+
+// Semaphores -------------------
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max_count,
+                                           UBaseType_t initial_count) {
+  return new HostSemaphore{.max_count = max_count, .count = initial_count};
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) { delete semaphore; }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t wait) {
+  if (semaphore->count == 0) {
+    host_stub::Idle(wait);
+    return pdFALSE;
+  }
+  --semaphore->count;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  if (semaphore->count >= semaphore->max_count) {
+    return pdFALSE;
+  }
+  ++semaphore->count;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore,
+                                 BaseType_t* high_task_awoken) {
+  return xSemaphoreGive(semaphore);
+}
+
+// Message buffers --------------
+
+MessageBufferHandle_t xMessageBufferCreate(size_t buffer_size) {
+  return new HostMessageBuffer{.buffer_size = buffer_size, .used = 0};
+}
+
+void vMessageBufferDelete(MessageBufferHandle_t buffer) { delete buffer; }
+
+size_t xMessageBufferSend(MessageBufferHandle_t buffer, const void* data,
+                          size_t size, TickType_t wait) {
+  const size_t required = size + sizeof(size_t);
+  if (buffer->used + required > buffer->buffer_size) {
+    return 0;
+  }
+  const uint8_t* const bytes = static_cast<const uint8_t*>(data);
+  buffer->records.emplace_back(bytes, bytes + size);
+  buffer->used += required;
+  return size;
+}
+
+size_t xMessageBufferSendFromISR(MessageBufferHandle_t buffer,
+                                 const void* data, size_t size,
+                                 BaseType_t* high_task_awoken) {
+  const size_t sent = xMessageBufferSend(buffer, data, size, 0);
+  if (sent != 0 && high_task_awoken != nullptr) {
+    *high_task_awoken = pdTRUE;
+  }
+  return sent;
+}
+
+size_t xMessageBufferReceive(MessageBufferHandle_t buffer, void* data,
+                             size_t size, TickType_t wait) {
+  if (buffer->records.empty()) {
+    host_stub::Idle(wait);
+    return 0;
+  }
+  const std::vector<uint8_t>& record = buffer->records.front();
+  if (record.size() > size) {
+    return 0;  // left in the buffer, as on target
+  }
+  const size_t length = record.size();
+  std::memcpy(data, record.data(), length);
+  buffer->used -= length + sizeof(size_t);
+  buffer->records.pop_front();
+  return length;
+}
@@ -0,0 +1,86 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_HOST_BLE_HS_H_
+#define BFOX_RECEIVER_HOST_STUBS_HOST_BLE_HS_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: the NimBLE host API used for scanning. Events come from
+// the simulated controller in nimble_sim.h.
+
+// Include ----------------------
+#include <cstdint>
+
+#define BLE_GAP_EVENT_CONNECT 0
+#define BLE_GAP_EVENT_DISCONNECT 1
+#define BLE_GAP_EVENT_DISC 7
+#define BLE_GAP_EVENT_DISC_COMPLETE 8
+
+#define BLE_HCI_SCAN_FILT_NO_WL 0
+#define BLE_HCI_SCAN_FILT_USE_WL 1
+
+#define BLE_HCI_ADV_RPT_EVTYPE_NONCONN_IND 3
+
+#define BLE_ADDR_PUBLIC 0x00
+#define BLE_ADDR_RANDOM 0x01
+
+#define BLE_HS_FOREVER INT32_MAX
+#define BLE_HS_EALREADY 2
+#define BLE_HS_EINVAL 3
+#define BLE_HS_EBUSY 15
+
+typedef struct {
+  uint8_t type;
+  uint8_t val[6];
+} ble_addr_t;
+
+struct ble_gap_disc_desc {
+  uint8_t event_type;
+  uint8_t length_data;
+  ble_addr_t addr;
+  int8_t rssi;
+  const uint8_t* data;
+  ble_addr_t direct_addr;
+};
+
+struct ble_gap_event {
+  uint8_t type;
+  union {
+    struct ble_gap_disc_desc disc;
+    struct {
+      int reason;
+    } disc_complete;
+  };
+};
+
+typedef int ble_gap_event_fn(struct ble_gap_event* event, void* arg);
+
+struct ble_gap_disc_params {
+  uint16_t itvl;
+  uint16_t window;
+  uint8_t filter_policy;
+  uint8_t limited;
+  uint8_t passive;
+  uint8_t filter_duplicates;
+};
+
+struct ble_store_status_event;
+
+typedef void ble_hs_sync_fn(void);
+typedef int ble_store_status_fn(struct ble_store_status_event* event,
+                                void* arg);
+
+struct ble_hs_cfg {
+  ble_hs_sync_fn* sync_cb;
+  ble_store_status_fn* store_status_cb;
+};
+extern struct ble_hs_cfg ble_hs_cfg;
+
+int ble_hs_id_infer_auto(int privacy, uint8_t* out_addr_type);
+
+int ble_gap_disc(uint8_t own_addr_type, int32_t duration_ms,
+                 const struct ble_gap_disc_params* disc_params,
+                 ble_gap_event_fn* cb, void* cb_arg);
+int ble_gap_disc_cancel(void);
+int ble_gap_disc_active(void);
+
+int ble_gap_wl_set(const ble_addr_t* addrs, uint8_t white_list_count);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_HOST_BLE_HS_H_
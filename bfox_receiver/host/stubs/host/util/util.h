@@ -0,0 +1,12 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_HOST_UTIL_UTIL_H_
+#define BFOX_RECEIVER_HOST_STUBS_HOST_UTIL_UTIL_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: NimBLE host utilities
+
+// Include ----------------------
+#include "host/ble_hs.h"
+
+int ble_store_util_status_rr(struct ble_store_status_event* event, void* arg);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_HOST_UTIL_UTIL_H_
@@ -0,0 +1,58 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_HOST_STUB_H_
+#define BFOX_RECEIVER_HOST_STUBS_HOST_STUB_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: simulation control.
+//
+// esp_timer_get_time() reads a simulated clock that only moves when the
+// simulation advances it, or when code waits: a blocking receive on an
+// empty queue, vTaskDelay or ets_delay_us. A wait never runs past the idle
+// limit, so the driver decides how far each step goes.
+
+// Include ----------------------
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+namespace host_stub {
+
+int64_t GetTimeUs();
+void SetTimeUs(const int64_t time_us);
+void AdvanceTimeUs(const int64_t delta_us);
+
+/// Waits end at this time at the latest (INT64_MAX: no limit)
+void SetIdleLimitUs(const int64_t limit_us);
+int64_t GetIdleLimitUs();
+
+/// A blocking wait of ticks (portMAX_DELAY: forever) with nothing to
+/// deliver: the clock moves to the end of the wait or the idle limit
+void Idle(const TickType_t ticks);
+
+/// Task handle for a simulated task (not run), e.g. the NimBLE host task
+TaskHandle_t CreateTask(const char* const name);
+void SetCurrentTask(const TaskHandle_t task);
+const char* GetTaskName(const TaskHandle_t task);
+
+/// xTaskNotifyGive count not taken yet
+uint32_t GetNotifyCount(const TaskHandle_t task);
+
+/// Runs with the current task switched, restored on scope exit
+class ScopedCurrentTask final {
+ public:
+  explicit ScopedCurrentTask(const TaskHandle_t task)
+      : previous_(xTaskGetCurrentTaskHandle()) {
+    SetCurrentTask(task);
+  }
+  ~ScopedCurrentTask() { SetCurrentTask(previous_); }
+
+  ScopedCurrentTask(const ScopedCurrentTask&) = delete;
+  ScopedCurrentTask& operator=(const ScopedCurrentTask&) = delete;
+
+ private:
+  TaskHandle_t previous_;
+};
+
+}  // namespace host_stub
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_HOST_STUB_H_
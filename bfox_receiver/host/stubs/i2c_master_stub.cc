@@ -0,0 +1,111 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: i2c_master driver on a simulated bus
+
+// Include ----------------------
+#include <driver/i2c_master.h>
+
+#include <utility>
+
+#include "i2c_sim.h"
+
+struct HostI2cBus {
+  i2c_sim::TransferHandler handler;
+  i2c_sim::BusStats stats;
+  uint32_t device_num;
+};
+
+struct HostI2cDevice {
+  HostI2cBus* bus;
+  uint16_t address;
+  uint32_t scl_speed_hz;
+  i2c_master_callback_t on_trans_done;
+  void* user_data;
+};
+
+namespace {
+
+// START + address byte + STOP, in SCL periods
+constexpr uint64_t kFramingClocks = 1 + 9 + 1;
+constexpr uint64_t kClocksPerByte = 9;
+
+}  // namespace
+
+esp_err_t i2c_master_bus_add_device(i2c_master_bus_handle_t bus_handle,
+                                    const i2c_device_config_t* dev_config,
+                                    i2c_master_dev_handle_t* ret_handle) {
+  if (bus_handle == nullptr || dev_config == nullptr ||
+      dev_config->scl_speed_hz == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  *ret_handle = new HostI2cDevice{.bus = bus_handle,
+                                  .address = dev_config->device_address,
+                                  .scl_speed_hz = dev_config->scl_speed_hz,
+                                  .on_trans_done = nullptr,
+                                  .user_data = nullptr};
+  ++bus_handle->device_num;
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_rm_device(i2c_master_dev_handle_t handle) {
+  if (handle == nullptr) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  --handle->bus->device_num;
+  delete handle;
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_register_event_callbacks(
+    i2c_master_dev_handle_t i2c_dev, const i2c_master_event_callbacks_t* cbs,
+    void* user_data) {
+  i2c_dev->on_trans_done = cbs->on_trans_done;
+  i2c_dev->user_data = user_data;
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_transmit(i2c_master_dev_handle_t i2c_dev,
+                              const uint8_t* write_buffer, size_t write_size,
+                              int xfer_timeout_ms) {
+  HostI2cBus* const bus = i2c_dev->bus;
+  ++bus->stats.transactions;
+  bus->stats.bytes += write_size;
+  bus->stats.bus_time_ns += (kFramingClocks + kClocksPerByte * write_size) *
+                            1000000000ull / i2c_dev->scl_speed_hz;
+  if (bus->handler) {
+    bus->handler(i2c_dev->address, write_buffer, write_size);
+  }
+
+  if (i2c_dev->on_trans_done != nullptr) {
+    const i2c_master_event_data_t event_data = {.event = I2C_EVENT_DONE};
+    i2c_dev->on_trans_done(i2c_dev, &event_data, i2c_dev->user_data);
+  }
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_bus_wait_all_done(i2c_master_bus_handle_t bus_handle,
+                                       int timeout_ms) {
+  return ESP_OK;
+}
+
+namespace i2c_sim {
+
+i2c_master_bus_handle_t CreateBus() {
+  return new HostI2cBus{.handler = nullptr, .stats = {}, .device_num = 0};
+}
+
+void DeleteBus(i2c_master_bus_handle_t bus) { delete bus; }
+
+void SetTransferHandler(i2c_master_bus_handle_t bus, TransferHandler handler) {
+  bus->handler = std::move(handler);
+}
+
+uint32_t GetSclSpeedHz(i2c_master_dev_handle_t device) {
+  return device->scl_speed_hz;
+}
+
+const BusStats& GetStats(i2c_master_bus_handle_t bus) { return bus->stats; }
+
+void ResetStats(i2c_master_bus_handle_t bus) { bus->stats = {}; }
+
+}  // namespace i2c_sim
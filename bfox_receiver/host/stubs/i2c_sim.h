@@ -0,0 +1,41 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_I2C_SIM_H_
+#define BFOX_RECEIVER_HOST_STUBS_I2C_SIM_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: simulated I2C bus. Every i2c_master_transmit reaches the
+// bus handler as one transaction and completes before it returns; the bus
+// time (START, address, data and STOP, 9 clocks per byte) is accounted but
+// the clock is not advanced.
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "driver/i2c_master.h"
+
+namespace i2c_sim {
+
+using TransferHandler = std::function<void(
+    const uint16_t address, const uint8_t* const data, const size_t size)>;
+
+struct BusStats {
+  uint32_t transactions;
+  uint32_t bytes;     // data bytes, without the address byte
+  uint64_t bus_time_ns;
+};
+
+i2c_master_bus_handle_t CreateBus();
+void DeleteBus(i2c_master_bus_handle_t bus);
+
+void SetTransferHandler(i2c_master_bus_handle_t bus, TransferHandler handler);
+
+/// SCL frequency the device was added with
+uint32_t GetSclSpeedHz(i2c_master_dev_handle_t device);
+
+const BusStats& GetStats(i2c_master_bus_handle_t bus);
+void ResetStats(i2c_master_bus_handle_t bus);
+
+}  // namespace i2c_sim
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_I2C_SIM_H_
@@ -0,0 +1,13 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_NIMBLE_NIMBLE_PORT_H_
+#define BFOX_RECEIVER_HOST_STUBS_NIMBLE_NIMBLE_PORT_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: NimBLE port
+
+// Include ----------------------
+#include "esp_err.h"
+
+esp_err_t nimble_port_init(void);
+void nimble_port_run(void);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_NIMBLE_NIMBLE_PORT_H_
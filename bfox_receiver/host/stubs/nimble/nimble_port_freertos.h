@@ -0,0 +1,14 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_NIMBLE_NIMBLE_PORT_FREERTOS_H_
+#define BFOX_RECEIVER_HOST_STUBS_NIMBLE_NIMBLE_PORT_FREERTOS_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: the host task is not run, nimble_sim delivers its events
+
+// Include ----------------------
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+void nimble_port_freertos_init(TaskFunction_t host_task_fn);
+void nimble_port_freertos_deinit(void);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_NIMBLE_NIMBLE_PORT_FREERTOS_H_
@@ -0,0 +1,56 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_NIMBLE_SIM_H_
+#define BFOX_RECEIVER_HOST_STUBS_NIMBLE_SIM_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: simulated BLE controller behind the NimBLE host API.
+//
+// Advertisements are reported to the ble_gap_disc callback on the simulated
+// NimBLE host task, after the controller filters: accept list (scan filter
+// policy) and duplicates (until the scan restarts). Scan interval and
+// window are not modeled, every advertisement is heard.
+
+// Include ----------------------
+#include <cstdint>
+
+#include "freertos/task.h"
+#include "host/ble_hs.h"
+
+namespace nimble_sim {
+
+struct Stats {
+  uint32_t scan_count;       // ble_gap_disc calls
+  uint32_t advertised;       // Advertise calls
+  uint32_t reported;         // BLE_GAP_EVENT_DISC delivered
+  uint32_t not_scanning;     // no scan running
+  uint32_t accept_list_filtered;
+  uint32_t duplicate_filtered;
+};
+
+/// The task GAP events are delivered on
+TaskHandle_t GetHostTask();
+
+/// Host synced with the controller: runs ble_hs_cfg.sync_cb
+void Sync();
+
+bool IsScanning();
+const ble_gap_disc_params& GetScanParams();
+
+/// End of the running scan [us], INT64_MAX if none or no duration
+int64_t GetScanEndUs();
+
+/// One advertisement on air now. Returns true if reported to the host.
+bool Advertise(const ble_addr_t& address, const int8_t rssi,
+               const uint8_t* const data, const uint8_t length);
+
+/// Completes the scan once its duration has passed
+/// (BLE_GAP_EVENT_DISC_COMPLETE)
+void Poll();
+
+const Stats& GetStats();
+
+/// Stop scanning, clear the accept list and the statistics
+void Reset();
+
+}  // namespace nimble_sim
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_NIMBLE_SIM_H_
@@ -0,0 +1,188 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: NimBLE host API on a simulated controller
+
+// Include ----------------------
+#include <esp_timer.h>
+
+#include <cstring>
+#include <vector>
+
+#include "host/ble_hs.h"
+#include "host/util/util.h"
+#include "host_stub.h"
+#include "nimble/nimble_port.h"
+#include "nimble/nimble_port_freertos.h"
+#include "nimble_sim.h"
+
+struct ble_hs_cfg ble_hs_cfg = {};
+
+namespace {
+
+constexpr size_t kAcceptListCapacity = 12;
+
+struct Scanner {
+  bool scanning;
+  ble_gap_disc_params params;
+  int64_t end_us;
+  ble_gap_event_fn* callback;
+  void* callback_arg;
+  std::vector<ble_addr_t> reported;  // duplicate filter
+  std::vector<ble_addr_t> accept_list;
+  nimble_sim::Stats stats;
+};
+
+Scanner scanner = {};
+TaskHandle_t host_task = nullptr;
+
+bool IsSameAddress(const ble_addr_t& a, const ble_addr_t& b) {
+  return a.type == b.type && std::memcmp(a.val, b.val, sizeof(a.val)) == 0;
+}
+
+bool Contains(const std::vector<ble_addr_t>& addresses,
+              const ble_addr_t& address) {
+  for (const ble_addr_t& entry : addresses) {
+    if (IsSameAddress(entry, address)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int Deliver(ble_gap_event* const event) {
+  host_stub::ScopedCurrentTask current_task(nimble_sim::GetHostTask());
+  return scanner.callback(event, scanner.callback_arg);
+}
+
+}  // namespace
+
+esp_err_t nimble_port_init(void) { return ESP_OK; }
+
+void nimble_port_run(void) {}
+
+void nimble_port_freertos_init(TaskFunction_t host_task_fn) {}
+
+void nimble_port_freertos_deinit(void) {}
+
+int ble_store_util_status_rr(struct ble_store_status_event* event, void* arg) {
+  return 0;
+}
+
+int ble_hs_id_infer_auto(int privacy, uint8_t* out_addr_type) {
+  *out_addr_type = BLE_ADDR_PUBLIC;
+  return 0;
+}
+
+int ble_gap_disc(uint8_t own_addr_type, int32_t duration_ms,
+                 const struct ble_gap_disc_params* disc_params,
+                 ble_gap_event_fn* cb, void* cb_arg) {
+  if (scanner.scanning) {
+    return BLE_HS_EALREADY;
+  }
+  scanner.scanning = true;
+  scanner.params = *disc_params;
+  scanner.end_us = (duration_ms == BLE_HS_FOREVER || duration_ms <= 0)
+                       ? INT64_MAX
+                       : esp_timer_get_time() + duration_ms * 1000ll;
+  scanner.callback = cb;
+  scanner.callback_arg = cb_arg;
+  scanner.reported.clear();
+  ++scanner.stats.scan_count;
+  return 0;
+}
+
+int ble_gap_disc_cancel(void) {
+  scanner.scanning = false;
+  return 0;
+}
+
+int ble_gap_disc_active(void) { return scanner.scanning ? 1 : 0; }
+
+int ble_gap_wl_set(const ble_addr_t* addrs, uint8_t white_list_count) {
+  // The controller rejects changes while scanning with the list
+  if (scanner.scanning &&
+      scanner.params.filter_policy == BLE_HCI_SCAN_FILT_USE_WL) {
+    return BLE_HS_EBUSY;
+  }
+  if (white_list_count > kAcceptListCapacity) {
+    return BLE_HS_EINVAL;
+  }
+  scanner.accept_list.assign(addrs, addrs + white_list_count);
+  return 0;
+}
+
+namespace nimble_sim {
+
+TaskHandle_t GetHostTask() {
+  if (host_task == nullptr) {
+    host_task = host_stub::CreateTask("nimble_host");
+  }
+  return host_task;
+}
+
+void Sync() {
+  if (ble_hs_cfg.sync_cb != nullptr) {
+    host_stub::ScopedCurrentTask current_task(GetHostTask());
+    ble_hs_cfg.sync_cb();
+  }
+}
+
+bool IsScanning() { return scanner.scanning; }
+
+const ble_gap_disc_params& GetScanParams() { return scanner.params; }
+
+int64_t GetScanEndUs() {
+  return scanner.scanning ? scanner.end_us : INT64_MAX;
+}
+
+bool Advertise(const ble_addr_t& address, const int8_t rssi,
+               const uint8_t* const data, const uint8_t length) {
+  ++scanner.stats.advertised;
+  if (!scanner.scanning) {
+    ++scanner.stats.not_scanning;
+    return false;
+  }
+  if (scanner.params.filter_policy == BLE_HCI_SCAN_FILT_USE_WL &&
+      !Contains(scanner.accept_list, address)) {
+    ++scanner.stats.accept_list_filtered;
+    return false;
+  }
+  if (scanner.params.filter_duplicates) {
+    if (Contains(scanner.reported, address)) {
+      ++scanner.stats.duplicate_filtered;
+      return false;
+    }
+    scanner.reported.push_back(address);
+  }
+
+  ble_gap_event event = {};
+  event.type = BLE_GAP_EVENT_DISC;
+  event.disc.event_type = BLE_HCI_ADV_RPT_EVTYPE_NONCONN_IND;
+  event.disc.length_data = length;
+  event.disc.addr = address;
+  event.disc.rssi = rssi;
+  event.disc.data = data;
+  ++scanner.stats.reported;
+  Deliver(&event);
+  return true;
+}
+
+void Poll() {
+  if (!scanner.scanning || esp_timer_get_time() < scanner.end_us) {
+    return;
+  }
+  scanner.scanning = false;
+  ble_gap_event event = {};
+  event.type = BLE_GAP_EVENT_DISC_COMPLETE;
+  event.disc_complete.reason = 0;
+  Deliver(&event);
+}
+
+const Stats& GetStats() { return scanner.stats; }
+
+void Reset() {
+  ble_hs_cfg = {};
+  scanner = {};
+}
+
+}  // namespace nimble_sim
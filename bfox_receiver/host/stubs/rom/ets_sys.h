@@ -0,0 +1,12 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_ROM_ETS_SYS_H_
+#define BFOX_RECEIVER_HOST_STUBS_ROM_ETS_SYS_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: busy wait, advances the simulated clock
+
+// Include ----------------------
+#include <cstdint>
+
+void ets_delay_us(uint32_t us);
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_ROM_ETS_SYS_H_
@@ -0,0 +1,9 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_SDKCONFIG_H_
+#define BFOX_RECEIVER_HOST_STUBS_SDKCONFIG_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: no power management, no console
+
+#define CONFIG_WL_SECTOR_SIZE 4096
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_SDKCONFIG_H_
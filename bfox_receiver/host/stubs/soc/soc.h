@@ -0,0 +1,10 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_SOC_SOC_H_
+#define BFOX_RECEIVER_HOST_STUBS_SOC_SOC_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: core numbers
+
+#define PRO_CPU_NUM (0)
+#define APP_CPU_NUM (1)
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_SOC_SOC_H_
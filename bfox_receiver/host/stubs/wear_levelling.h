@@ -0,0 +1,14 @@
+#ifndef BFOX_RECEIVER_HOST_STUBS_WEAR_LEVELLING_H_
+#define BFOX_RECEIVER_HOST_STUBS_WEAR_LEVELLING_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Host build stub: wear levelling handle
+
+// Include ----------------------
+#include <cstdint>
+
+typedef int32_t wl_handle_t;
+
+#define WL_INVALID_HANDLE -1
+
+#endif  // BFOX_RECEIVER_HOST_STUBS_WEAR_LEVELLING_H_
@@ -0,0 +1,143 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Advertisement parse cost per packet, accepted and rejected frames.
+//
+// Usage: ad_parser_bench [iterations]
+// Times ParseBeaconFrame with the receiver's decoders and
+// BeaconTracker::Match (parse + group lookup, what GapEvent runs per
+// report), next to the exact-header check the receiver used before the AD
+// iterator. Host figures; the C6 (160MHz RISC-V) is roughly 20-40x slower.
+
+// Include ----------------------
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ad_parser.h"
+#include "beacon_payload.h"
+#include "beacon_tracker.h"
+#include "ibeacon.h"
+#include "receiver_sim.h"
+#include "test_check.h"
+
+using namespace bfox_receiver_system;
+
+namespace {
+
+constexpr uint32_t kDefaultIterations = 1000000;
+
+struct Case {
+  const char* name;
+  sim::Payload payload;
+  bool parsed;  // by the receiver's decoders
+  int group;    // BeaconTracker::Match result
+};
+
+/// The receiver's check before the AD iterator: the whole payload had to
+/// be a 0x1e byte iBeacon with a fixed flags AD
+bool IsIBeaconPacketLegacy(const uint8_t* const data, const uint8_t length) {
+  return data != nullptr && length == 0x1e &&
+         std::memcmp(data, &kIBeaconHeader, sizeof(kIBeaconHeader)) == 0;
+}
+
+template <typename Function>
+double MeasureNs(const sim::Payload& payload, const uint32_t iterations,
+                 Function function) {
+  // Keep the results alive so the loop is not optimized away
+  volatile int sink = 0;
+  const uint8_t length = static_cast<uint8_t>(payload.size());
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < iterations; ++i) {
+    sink = sink + function(payload.data(), length);
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         iterations;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const uint32_t iterations =
+      (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : kDefaultIterations;
+
+  const uint8_t* const uuid = sim::ReceiverSim::kTargetProximityUuid;
+  uint8_t other_uuid[16];
+  std::memcpy(other_uuid, uuid, sizeof(other_uuid));
+  other_uuid[15] ^= 0xFF;
+  const uint8_t instance[6] = {0, 0, 0, 0, 0, 7};
+
+  sim::Payload extra_fields = sim::MakeIBeacon(uuid, 3, 7, -59);
+  extra_fields[2] = 0x1A;  // other flags
+  const uint8_t name[] = {0x04, 0x09, 'F', 'O', 'X'};
+  extra_fields.insert(extra_fields.end(), name, name + sizeof(name));
+  sim::Payload truncated = sim::MakeIBeacon(uuid, 3, 7, -59);
+  truncated.resize(20);
+
+  const std::vector<Case> cases = {
+      {"ibeacon target", sim::MakeIBeacon(uuid, 3, 7, -59), true, 3},
+      {"ibeacon other flags+name", extra_fields, true, 3},
+      {"altbeacon target", sim::MakeAltBeacon(uuid, 3, 7, -59), true, 3},
+      {"ibeacon other major", sim::MakeIBeacon(uuid, 42, 7, -59), true, -1},
+      {"ibeacon other uuid", sim::MakeIBeacon(other_uuid, 3, 7, -59), true,
+       -1},
+      {"eddystone uid", sim::MakeEddystoneUid(uuid, instance, -18), false, -1},
+      {"eddystone tlm", sim::MakeEddystoneTlm(3000, 22 * 256), false, -1},
+      {"foreign", sim::MakeForeign(), false, -1},
+      {"truncated", truncated, false, -1},
+  };
+
+  const std::vector<BeaconGroup> groups = [&]() {
+    std::vector<BeaconGroup> result(sim::ReceiverSim::kCourseNum);
+    for (size_t course = 0; course < result.size(); ++course) {
+      std::memcpy(result[course].proximity_uuid, uuid, 16);
+      result[course].major = static_cast<uint16_t>(course);
+    }
+    return result;
+  }();
+  const BeaconTracker tracker(groups.data(), groups.size());
+
+  std::printf("%u iterations, ns per packet\n", iterations);
+  std::printf("%-26s %8s %8s %8s %8s\n", "frame", "result", "legacy", "parse",
+              "match");
+  for (const Case& test_case : cases) {
+    BeaconFrame frame;
+    const uint8_t length = static_cast<uint8_t>(test_case.payload.size());
+    CHECK(ParseBeaconFrame<ad_decoder::IBeacon, ad_decoder::AltBeacon>(
+              test_case.payload.data(), length, &frame) == test_case.parsed);
+    const int group = tracker.Match(test_case.payload.data(), length, &frame);
+    CHECK(group == test_case.group);
+
+    const double legacy_ns = MeasureNs(
+        test_case.payload, iterations,
+        [](const uint8_t* data, uint8_t size) {
+          return IsIBeaconPacketLegacy(data, size) ? 1 : 0;
+        });
+    const double parse_ns = MeasureNs(
+        test_case.payload, iterations,
+        [&frame](const uint8_t* data, uint8_t size) {
+          return ParseBeaconFrame<ad_decoder::IBeacon, ad_decoder::AltBeacon>(
+                     data, size, &frame)
+                     ? 1
+                     : 0;
+        });
+    const double match_ns = MeasureNs(
+        test_case.payload, iterations,
+        [&tracker, &frame](const uint8_t* data, uint8_t size) {
+          return tracker.Match(data, size, &frame);
+        });
+    std::printf("%-26s %8s %8.1f %8.1f %8.1f\n", test_case.name,
+                (group >= 0) ? "accept" : "reject", legacy_ns, parse_ns,
+                match_ns);
+  }
+
+  // Eddystone decoders are compiled in only where listed
+  BeaconFrame frame;
+  const sim::Payload tlm = sim::MakeEddystoneTlm(3000, 22 * 256);
+  CHECK(ParseBeaconFrame<ad_decoder::EddystoneTlm>(
+      tlm.data(), static_cast<uint8_t>(tlm.size()), &frame));
+  CHECK(frame.battery_mv == 3000 && frame.temperature_x256 == 22 * 256);
+  return test_check::TestResult();
+}
@@ -0,0 +1,99 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// MessageQueue backends on the host FreeRTOS stub: delivery, the ISR yield
+// flag, task notification binding and depth, message buffer record lengths
+
+// Include ----------------------
+#include <cstdint>
+
+#include "host_stub.h"
+#include "message_queue.h"
+#include "test_check.h"
+
+using namespace bfox_receiver_system;
+
+namespace {
+
+struct Record {
+  uint32_t sent_us;
+  uint8_t payload[12];
+};
+
+void TestQueueBackend() {
+  MessageQueue<uint32_t> queue;
+  CHECK(queue.Create(2));
+  BaseType_t awoken = pdFALSE;
+  CHECK(queue.SendFromISR(1, &awoken));
+  CHECK(awoken == pdTRUE);
+  CHECK(queue.Send(2));
+  CHECK(!queue.Send(3));  // full
+
+  uint32_t value = 0;
+  CHECK(queue.ReceiveNonBlock(&value) && value == 1);
+  CHECK(queue.ReceiveNonBlock(&value) && value == 2);
+  CHECK(!queue.ReceiveNonBlock(&value));
+}
+
+void TestTaskNotifyBackend() {
+  TaskHandle_t receiver = host_stub::CreateTask("receiver");
+  MessageQueue<uint32_t, TaskNotifyBackend> notify;
+  CHECK(notify.Create());
+
+  uint32_t value = 0;
+  CHECK(!notify.Send(1));  // no receiver bound yet
+  {
+    host_stub::ScopedCurrentTask current(receiver);
+    CHECK(!notify.ReceiveNonBlock(&value));  // binds
+  }
+
+  BaseType_t awoken = pdFALSE;
+  CHECK(notify.SendFromISR(2, &awoken));
+  CHECK(awoken == pdTRUE);
+  CHECK(!notify.Send(3));  // depth 1, the pending value is kept
+  {
+    host_stub::ScopedCurrentTask current(receiver);
+    CHECK(notify.ReceiveNonBlock(&value) && value == 2);
+    CHECK(!notify.ReceiveNonBlock(&value));
+  }
+  CHECK(notify.Send(4));
+  {
+    host_stub::ScopedCurrentTask current(receiver);
+    CHECK(notify.ReceiveNonBlock(&value) && value == 4);
+  }
+
+  notify.Destroy();
+  vTaskDelete(receiver);
+}
+
+void TestMessageBufferBackend() {
+  MessageQueue<Record, MessageBufferBackend> buffer;
+  CHECK(buffer.Create(2));  // room for two whole records
+
+  const Record sent = {.sent_us = 100, .payload = {1, 2, 3, 4}};
+  BaseType_t awoken = pdFALSE;
+  CHECK(buffer.SendFromISR(sent, &awoken));
+  CHECK(awoken == pdTRUE);
+  CHECK(!buffer.SendRecordFromISR(sent, sizeof(sent) + 1, &awoken));
+  // The second whole record's room holds two short ones
+  CHECK(buffer.SendRecordFromISR(sent, sizeof(sent.sent_us), &awoken));
+  CHECK(buffer.SendRecordFromISR(sent, sizeof(sent.sent_us), &awoken));
+  CHECK(!buffer.SendRecordFromISR(sent, sizeof(sent.sent_us), &awoken));
+
+  Record received = {};
+  CHECK(buffer.ReceiveRecord(&received, 0) == sizeof(Record));
+  CHECK(received.payload[3] == 4);
+  received = {};
+  CHECK(buffer.ReceiveRecord(&received, 0) == sizeof(received.sent_us));
+  CHECK(received.sent_us == 100 && received.payload[0] == 0);
+  CHECK(buffer.ReceiveRecord(&received, 0) == sizeof(received.sent_us));
+  CHECK(buffer.ReceiveRecord(&received, 0) == 0);
+}
+
+}  // namespace
+
+int main() {
+  TestQueueBackend();
+  TestTaskNotifyBackend();
+  TestMessageBufferBackend();
+  return test_check::TestResult();
+}
@@ -0,0 +1,133 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Receive path on the host: scripted advertisements through
+// BeaconReceiveTask::GapEvent, BeaconTracker and the search screen on the
+// LCD model
+
+// Include ----------------------
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "beacon_tracker.h"
+#include "gap_script.h"
+#include "host_stub.h"
+#include "nimble_sim.h"
+#include "perf_counters.h"
+#include "receiver_sim.h"
+#include "test_check.h"
+
+using bfox_receiver_system::BeaconReceiveTask;
+using bfox_receiver_system::BeaconTracker;
+using bfox_receiver_system::sim::GapScriptEvent;
+using bfox_receiver_system::sim::ParseGapScript;
+using bfox_receiver_system::sim::ReceiverSim;
+
+namespace {
+
+int64_t NowMs() { return host_stub::GetTimeUs() / 1000; }
+
+/// BeaconReceiveTask::Update calls so far
+uint32_t GetUpdateCount() {
+  namespace perf = bfox_receiver_system::perf;
+  for (const perf::Histogram* histogram = perf::GetFirstHistogram();
+       histogram != nullptr; histogram = histogram->GetNext()) {
+    if (std::strcmp(histogram->GetName(), "receive.update_us") == 0) {
+      return histogram->GetCount();
+    }
+  }
+  return 0;
+}
+
+/// Two beacons of course 1, one of course 2 and a foreign device, every
+/// 100ms for duration_ms
+std::string MakeScript(const int64_t duration_ms) {
+  std::ostringstream script;
+  script << "# time kind ...\n";
+  for (int64_t time_ms = 0; time_ms < duration_ms; time_ms += 100) {
+    script << time_ms << " ibeacon 1 7 -55\n";
+    script << time_ms + 20 << " ibeacon 1 3 -75 -60\n";
+    script << time_ms + 40 << " altbeacon 2 9 -40\n";
+    script << time_ms + 60 << " foreign 4660 -30\n";
+  }
+  return script.str();
+}
+
+void TestScriptParser() {
+  std::vector<GapScriptEvent> events;
+  std::string error;
+  std::istringstream script("20 ibeacon 1 2 -60\n\n10 foreign 1 -40 # x\n");
+  CHECK(ParseGapScript(script, ReceiverSim::kTargetProximityUuid, &events,
+                       &error));
+  CHECK(events.size() == 2);
+  CHECK(events.size() == 2 && events[0].time_ms == 10 &&
+        events[1].time_ms == 20 && events[1].rssi == -60);
+
+  std::istringstream bad_script("0 ibeacon 1 2 -60\n5 ibeacon 1 70000 -60\n");
+  CHECK(!ParseGapScript(bad_script, ReceiverSim::kTargetProximityUuid, &events,
+                        &error));
+  CHECK(error == "line 2: bad event");
+}
+
+void TestReceivePath() {
+  ReceiverSim sim(1);
+  sim.Start();
+  CHECK(nimble_sim::IsScanning());
+
+  std::vector<GapScriptEvent> events;
+  std::string error;
+  std::istringstream script(MakeScript(6000));
+  CHECK(ParseGapScript(script, ReceiverSim::kTargetProximityUuid, &events,
+                       &error));
+  sim.Replay(events);
+  sim.RunUntilMs(NowMs() + BeaconReceiveTask::kDrainIntervalMs);
+
+  // Strongest beacon of the active course first
+  CHECK(sim.RenderIfChanged());
+  CHECK(sim.GetLcdLine(0)[0] == '7');
+  CHECK(sim.GetLcdLine(1)[0] == '3');
+  CHECK(sim.GetTask().GetGroupOccupancy(0) == 0);
+  CHECK(sim.GetTask().GetGroupOccupancy(1) == 2);
+  CHECK(sim.GetTask().GetGroupOccupancy(2) == 1);
+
+  // Scan phases restarted; duplicates and, once the beacons were learned,
+  // the foreign device were dropped by the controller
+  const nimble_sim::Stats& stats = nimble_sim::GetStats();
+  CHECK(stats.scan_count > 1);
+  CHECK(stats.duplicate_filtered > 0);
+  CHECK(stats.accept_list_filtered > 0);
+  CHECK(stats.reported < stats.advertised);
+  CHECK(sim.GetTask().GetScanDroppedCount() == 0);
+
+  // Another course is published on the next loop tick
+  sim.GetTask().SetActiveGroup(2);
+  sim.RunUntilMs(NowMs() + bfox_receiver_system::EventLoop::kTickMs);
+  CHECK(sim.RenderIfChanged());
+  CHECK(sim.GetLcdLine(0)[0] == '9');
+  CHECK(sim.GetLcdLine(1) == std::string(16, ' '));
+
+  // Silence: the beacons expire, one wakeup per expiry time at most
+  const uint32_t update_count = GetUpdateCount();
+  sim.RunUntilMs(NowMs() + BeaconTracker::kBeaconExpiryMs + 1);
+  CHECK(sim.RenderIfChanged());
+  CHECK(sim.GetLcdLine(0) == "NO SIGNAL       ");
+  CHECK(sim.GetTask().GetBeaconTableOccupancy() == 0);
+  CHECK(GetUpdateCount() - update_count <= 3);  // three beacons
+
+  // Nothing tracked: no wakeup, nothing is drawn
+  const uint32_t idle_update_count = GetUpdateCount();
+  const uint32_t render_count = sim.GetRenderCount();
+  sim.RunUntilMs(NowMs() + 60000);
+  CHECK(GetUpdateCount() == idle_update_count);
+  CHECK(!sim.RenderIfChanged());
+  CHECK(sim.GetRenderCount() == render_count);
+}
+
+}  // namespace
+
+int main() {
+  TestScriptParser();
+  TestReceivePath();
+  return test_check::TestResult();
+}
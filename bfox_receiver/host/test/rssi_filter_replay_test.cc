@@ -0,0 +1,233 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Replays RSSI traces through every RssiFilter mode and reports how fast
+// each one follows a level change and how much noise it removes.
+//
+// Usage: rssi_filter_replay_test <trace.csv>...
+// Trace lines are "time_ms,rssi[,level]" ('#' comments). The level column
+// (true mean RSSI, known for synthetic traces) enables the convergence
+// figure and the checks; recorded traces (scan_trace_replay --csv) report
+// variance only. Every trace also checks that a filter saved halfway and
+// restored into a new one (warm resume) gives the same output.
+
+// Include ----------------------
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "rssi_filter.h"
+#include "test_check.h"
+
+using bfox_receiver_system::RssiFilter;
+using bfox_receiver_system::RssiFilterMode;
+
+namespace {
+
+constexpr int kConvergedDb = 3;        // within the level by
+constexpr size_t kConvergedRun = 3;    // for consecutive samples
+constexpr int kLevelStepDb = 6;        // level changes measured
+constexpr size_t kSettleSamples = 10;  // skipped before steady state
+
+struct Sample {
+  int32_t rssi;
+  int32_t level;
+};
+
+struct Trace {
+  std::string name;
+  std::vector<Sample> samples;
+  bool has_level;
+};
+
+struct Result {
+  double variance;          // steady state [dB^2]
+  double convergence;       // mean samples to converge after a level step
+  size_t step_count;
+  size_t unconverged_count;
+};
+
+struct ModeName {
+  RssiFilterMode mode;
+  const char* name;
+};
+
+constexpr ModeName kModes[] = {
+    {RssiFilterMode::kRaw, "raw"},
+    {RssiFilterMode::kEma, "ema"},
+    {RssiFilterMode::kKalman, "kalman"},
+    {RssiFilterMode::kMedian, "median"},
+};
+
+bool LoadTrace(const char* const path, Trace* const trace) {
+  std::ifstream input(path);
+  if (!input) {
+    return false;
+  }
+  trace->name = path;
+  trace->has_level = true;
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    long time_ms = 0;
+    char comma = 0;
+    Sample sample = {};
+    if (!(fields >> time_ms >> comma >> sample.rssi)) {
+      continue;  // header
+    }
+    if (!(fields >> comma >> sample.level)) {
+      trace->has_level = false;
+    }
+    trace->samples.push_back(sample);
+  }
+  return !trace->samples.empty();
+}
+
+/// Variance around the mean of each constant-level segment, skipping the
+/// settling samples after every change (whole trace without levels)
+double SteadyVariance(const Trace& trace, const std::vector<int32_t>& output) {
+  double sum = 0;
+  double square_sum = 0;
+  size_t count = 0;
+  double total = 0;
+  size_t total_count = 0;
+  size_t segment_begin = 0;
+  for (size_t i = 0; i <= output.size(); ++i) {
+    const bool segment_end =
+        (i == output.size()) ||
+        (trace.has_level && trace.samples[i].level !=
+                                trace.samples[segment_begin].level);
+    if (!segment_end) {
+      continue;
+    }
+    const size_t skip = trace.has_level ? kSettleSamples : 0;
+    sum = 0;
+    square_sum = 0;
+    count = 0;
+    for (size_t j = segment_begin + skip; j < i; ++j) {
+      sum += output[j];
+      square_sum += static_cast<double>(output[j]) * output[j];
+      ++count;
+    }
+    if (count > 1) {
+      total += square_sum - sum * sum / count;
+      total_count += count - 1;
+    }
+    segment_begin = i;
+  }
+  return (total_count != 0) ? total / total_count : 0;
+}
+
+Result Replay(const Trace& trace, const RssiFilterMode mode) {
+  RssiFilter filter;
+  std::vector<int32_t> output;
+  output.reserve(trace.samples.size());
+  for (const Sample& sample : trace.samples) {
+    output.push_back(filter.Apply(mode, sample.rssi));
+  }
+
+  Result result = {.variance = SteadyVariance(trace, output)};
+  if (!trace.has_level) {
+    return result;
+  }
+  size_t converge_sum = 0;
+  for (size_t i = 1; i < output.size(); ++i) {
+    const int32_t level = trace.samples[i].level;
+    if (std::abs(level - trace.samples[i - 1].level) < kLevelStepDb) {
+      continue;
+    }
+    ++result.step_count;
+    size_t run = 0;
+    size_t j = i;
+    for (; j < output.size() && trace.samples[j].level == level; ++j) {
+      run = (std::abs(output[j] - level) <= kConvergedDb) ? run + 1 : 0;
+      if (run == kConvergedRun) {
+        break;
+      }
+    }
+    if (run == kConvergedRun) {
+      converge_sum += j + 1 - kConvergedRun - i + 1;  // samples incl. first
+    } else {
+      ++result.unconverged_count;
+    }
+  }
+  const size_t converged = result.step_count - result.unconverged_count;
+  result.convergence =
+      (converged != 0) ? static_cast<double>(converge_sum) / converged : 0;
+  return result;
+}
+
+/// Save halfway, restore into a new filter (as over deep sleep) and go on:
+/// the output must match an uninterrupted run
+bool ResumesFromSnapshot(const Trace& trace, const RssiFilterMode mode) {
+  RssiFilter reference;
+  RssiFilter first_half;
+  RssiFilter second_half;
+  const size_t half = trace.samples.size() / 2;
+  for (size_t i = 0; i < trace.samples.size(); ++i) {
+    const int32_t rssi = trace.samples[i].rssi;
+    if (i == half) {
+      const RssiFilter::Snapshot snapshot = first_half.Save();
+      second_half.Restore(snapshot);
+    }
+    RssiFilter& resumed = (i < half) ? first_half : second_half;
+    if (resumed.Apply(mode, rssi) != reference.Apply(mode, rssi)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  CHECK(argc > 1);
+  for (int arg = 1; arg < argc; ++arg) {
+    Trace trace;
+    if (!LoadTrace(argv[arg], &trace)) {
+      std::fprintf(stderr, "Cannot read trace %s\n", argv[arg]);
+      CHECK(false);
+      continue;
+    }
+
+    std::printf("%s (%zu samples)\n", trace.name.c_str(),
+                trace.samples.size());
+    std::printf("  %-7s %10s %10s %12s\n", "filter", "var[dB2]", "reduction",
+                "converge[n]");
+    const Result raw = Replay(trace, RssiFilterMode::kRaw);
+    for (const ModeName& mode : kModes) {
+      const Result result = Replay(trace, mode.mode);
+      const double reduction =
+          (result.variance > 0) ? raw.variance / result.variance : 0;
+      char convergence[16] = "-";
+      if (trace.has_level && result.step_count != 0) {
+        std::snprintf(convergence, sizeof(convergence), "%.1f%s",
+                      result.convergence,
+                      (result.unconverged_count != 0) ? "*" : "");
+      }
+      std::printf("  %-7s %10.2f %9.2fx %12s\n", mode.name, result.variance,
+                  reduction, convergence);
+      CHECK(ResumesFromSnapshot(trace, mode.mode));
+
+      if (mode.mode == RssiFilterMode::kRaw) {
+        continue;
+      }
+      // On the reference traces every filter must remove noise and still
+      // follow a walk-in; recorded traces are only reported
+      if (trace.has_level) {
+        CHECK(result.variance < raw.variance / 2);
+        CHECK(result.unconverged_count == 0);
+        CHECK(result.convergence <= 2 * kSettleSamples);
+      }
+    }
+  }
+  std::printf("(converge: samples until within %ddB of a new level for %zu "
+              "samples, * some never did)\n",
+              kConvergedDb, kConvergedRun);
+  return test_check::TestResult();
+}
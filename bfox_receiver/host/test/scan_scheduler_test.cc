@@ -0,0 +1,124 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// ScanScheduler idle windows against the beacons' advertising interval:
+// every idle window must hold an advertising event whatever the interval
+// (default, faster, slower, past the scan interval limit), and the receive
+// task must size the window from its group table
+
+// Include ----------------------
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "host_stub.h"
+#include "nimble_sim.h"
+#include "receiver_sim.h"
+#include "scan_scheduler.h"
+#include "test_check.h"
+
+using bfox_receiver_system::ScanScheduler;
+using bfox_receiver_system::sim::ReceiverSim;
+
+namespace {
+
+double UnitsToMs(const uint16_t units) { return units * 0.625; }
+
+/// Advertising events from offset_ms, each advertising interval plus an
+/// advDelay of 0 or kAdvDelayMarginMs (both extremes, alternating or not)
+std::vector<double> MakeAdvEvents(const uint32_t adv_interval_ms,
+                                  const double offset_ms,
+                                  const double end_ms, const bool alternate) {
+  std::vector<double> events;
+  uint32_t count = 0;
+  for (double time_ms = offset_ms; time_ms < end_ms; ++count) {
+    events.push_back(time_ms);
+    const bool delayed = !alternate || (count % 2 != 0);
+    time_ms += adv_interval_ms +
+               (delayed ? ScanScheduler::kAdvDelayMarginMs : 0);
+  }
+  return events;
+}
+
+/// Every scan window of the phase holds at least one event
+bool EveryWindowHoldsEvent(const ScanScheduler::ScanParams& params,
+                           const std::vector<double>& events) {
+  const double itvl_ms = UnitsToMs(params.itvl);
+  const double window_ms = UnitsToMs(params.window);
+  for (double start_ms = 0; start_ms < params.duration_ms;
+       start_ms += itvl_ms) {
+    const bool held =
+        std::any_of(events.begin(), events.end(), [&](const double event) {
+          return start_ms <= event && event < start_ms + window_ms;
+        });
+    if (!held) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ScanScheduler::ScanParams IdlePhase(const uint32_t adv_interval_ms) {
+  ScanScheduler scheduler;
+  scheduler.SetBeaconAdvIntervalMs(adv_interval_ms);
+  // Past the fast hold after boot
+  return scheduler.BeginPhase(ScanScheduler::kTargetHoldMs, 0);
+}
+
+void TestIdleWindowCoversAdvInterval() {
+  const uint32_t adv_intervals_ms[] = {
+      100, ScanScheduler::kDefaultBeaconAdvIntervalMs, 1000, 2000,
+      ScanScheduler::kMaxIdleAdvIntervalMs, 5000, 10240};
+  for (const uint32_t adv_interval_ms : adv_intervals_ms) {
+    const ScanScheduler::ScanParams params = IdlePhase(adv_interval_ms);
+    CHECK(!params.fast);
+    CHECK(params.window <= params.itvl);
+    CHECK(UnitsToMs(params.itvl) <= ScanScheduler::kMaxScanIntervalMs);
+    CHECK(params.duration_ms >= UnitsToMs(params.itvl));
+    if (adv_interval_ms <= ScanScheduler::kMaxIdleAdvIntervalMs) {
+      CHECK(params.itvl == params.window * ScanScheduler::kIdleDutyDivider);
+    }
+
+    // Any phase of the beacon against the scan windows
+    const double end_ms = params.duration_ms + UnitsToMs(params.itvl);
+    for (uint32_t step = 0; step < 20; ++step) {
+      const double offset_ms = -static_cast<double>(adv_interval_ms) *
+                               step / 20;
+      CHECK(EveryWindowHoldsEvent(
+          params, MakeAdvEvents(adv_interval_ms, offset_ms, end_ms, true)));
+      CHECK(EveryWindowHoldsEvent(
+          params, MakeAdvEvents(adv_interval_ms, offset_ms, end_ms, false)));
+    }
+  }
+
+  // Not set (0): the default
+  const ScanScheduler::ScanParams unset = IdlePhase(0);
+  const ScanScheduler::ScanParams by_default =
+      IdlePhase(ScanScheduler::kDefaultBeaconAdvIntervalMs);
+  CHECK(unset.window == by_default.window && unset.itvl == by_default.itvl);
+}
+
+/// The receive task takes the interval from its group table
+void TestReceiveTaskUsesGroupAdvInterval() {
+  constexpr uint16_t kAdvIntervalMs = 2000;
+  ReceiverSim receiver(0, bfox_receiver_system::BeaconReceiveTask::
+                              kDefaultRssiFilterMode,
+                       kAdvIntervalMs);
+  receiver.Start();
+  // No target heard: idle after the fast hold
+  receiver.RunUntilMs(host_stub::GetTimeUs() / 1000 +
+                      ScanScheduler::kTargetHoldMs * 2);
+
+  const ble_gap_disc_params& params = nimble_sim::GetScanParams();
+  CHECK(nimble_sim::IsScanning());
+  CHECK(UnitsToMs(params.window) >=
+        kAdvIntervalMs + ScanScheduler::kAdvDelayMarginMs);
+  CHECK(params.itvl == params.window * ScanScheduler::kIdleDutyDivider);
+}
+
+}  // namespace
+
+int main() {
+  TestIdleWindowCoversAdvInterval();
+  TestReceiveTaskUsesGroupAdvInterval();
+  return test_check::TestResult();
+}
@@ -0,0 +1,115 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Scan trace round trip (recorder encoding, reader) and replay into the
+// ranking
+
+// Include ----------------------
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "scan_trace_reader.h"
+#include "test_check.h"
+
+using namespace bfox_receiver_system;
+
+namespace {
+
+constexpr uint32_t kStartMs = 4000000000u;  // wraps during the trace
+
+/// Course 1: minor 3 steady, minor 7 walked in on and passing it; course 2
+/// in the background; then a pause longer than a record's dt_ms
+std::vector<ScanRecord> MakeRecords() {
+  std::vector<ScanRecord> records;
+  uint32_t time_ms = kStartMs + 100;
+  for (int step = 0; step < 40; ++step, time_ms += 500) {
+    records.push_back({.timestamp_ms = time_ms,
+                       .minor = 3,
+                       .rssi = -75,
+                       .measured_power = -59,
+                       .group = 1});
+    records.push_back({.timestamp_ms = time_ms + 120,
+                       .minor = 7,
+                       .rssi = static_cast<int8_t>(-90 + step),
+                       .measured_power = -59,
+                       .group = 1});
+    records.push_back({.timestamp_ms = time_ms + 240,
+                       .minor = 9,
+                       .rssi = -50,
+                       .measured_power = -59,
+                       .group = 2});
+  }
+  records.push_back({.timestamp_ms = time_ms + 200000,
+                     .minor = 3,
+                     .rssi = -70,
+                     .measured_power = -59,
+                     .group = 1});
+  return records;
+}
+
+}  // namespace
+
+int main() {
+  const std::string path = "scan_trace_replay_test.bin";
+  const std::vector<ScanRecord> records = MakeRecords();
+  CHECK(scan_trace::Write(path, kStartMs, records));
+
+  // Power lost in the middle of a record
+  FILE* const file = std::fopen(path.c_str(), "ab");
+  CHECK(file != nullptr);
+  std::fwrite("\x10\x00\x03", 3, 1, file);
+  std::fclose(file);
+
+  scan_trace::Trace trace;
+  std::string error;
+  CHECK(scan_trace::Read(path, &trace, &error));
+  CHECK(trace.records.size() == records.size());
+  CHECK(trace.time_gap_count == 200000 / UINT16_MAX);
+  bool same = trace.records.size() == records.size();
+  for (size_t i = 0; same && i < records.size(); ++i) {
+    same = trace.records[i].timestamp_ms == records[i].timestamp_ms &&
+           trace.records[i].minor == records[i].minor &&
+           trace.records[i].rssi == records[i].rssi &&
+           trace.records[i].group == records[i].group;
+  }
+  CHECK(same);
+
+  // Course 1 as the search screen shows it
+  std::vector<BeaconTracker::RankedItems> screens;
+  std::vector<int64_t> times;
+  scan_trace::Replay(
+      trace,
+      {.group = 1,
+       .rssi_filter_mode = RssiFilterMode::kEma,
+       .path_loss_exponent_x10 = 20},
+      [&](const int64_t time_ms,
+          const BeaconTracker::RankedItems& ranked_items) {
+        times.push_back(time_ms);
+        screens.push_back(ranked_items);
+      });
+  CHECK(screens.size() > 3);
+  if (screens.size() > 3) {
+    CHECK(screens[0].count == 1 && screens[0].items[0].minor == 3);
+    CHECK(screens[1].count == 2 && screens[1].items[0].minor == 3);
+    // Walked in: minor 7 ends up first
+    size_t overtaken = 0;
+    for (size_t i = 0; i < screens.size() && overtaken == 0; ++i) {
+      if (screens[i].count == 2 && screens[i].items[0].minor == 7) {
+        overtaken = i;
+      }
+    }
+    CHECK(overtaken != 0);
+    // Both expire in the pause, minor 3 comes back alone, then expires
+    const BeaconTracker::RankedItems& last = screens.back();
+    const BeaconTracker::RankedItems& before_last = screens[screens.size() - 2];
+    CHECK(last.count == 0);
+    CHECK(before_last.count == 1 && before_last.items[0].minor == 3);
+    CHECK(times.back() > trace.end_ms);
+  }
+
+  // The file is kept, the CSV export test reads it
+  CHECK(!scan_trace::Read("scan_trace_replay_test_missing.bin", &trace,
+                          &error));
+  CHECK(!scan_trace::Read("/dev/null", &trace, &error));
+  return test_check::TestResult();
+}
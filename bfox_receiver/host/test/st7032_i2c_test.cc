@@ -0,0 +1,220 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// ST7032 I2C traffic per search screen frame on the simulated bus, against
+// the per-character driver it replaced, and the DDRAM read back from the
+// controller model
+
+// Include ----------------------
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "beacon_tracker.h"
+#include "i2c_sim.h"
+#include "lcd_model.h"
+#include "search_view.h"
+#include "st7032.h"
+#include "test_check.h"
+
+using namespace bfox_receiver_system;
+
+namespace {
+
+using RankedItems = BeaconTracker::RankedItems;
+
+/// Wire bytes include the address byte of each transaction
+struct Traffic {
+  uint32_t transactions;
+  uint32_t wire_bytes;
+  double bus_us;
+  double busy_wait_us;  // CPU spinning in the driver
+};
+
+Traffic GetTraffic(i2c_master_bus_handle_t bus, const double busy_wait_us) {
+  const i2c_sim::BusStats& stats = i2c_sim::GetStats(bus);
+  return Traffic{.transactions = stats.transactions,
+                 .wire_bytes = stats.bytes + stats.transactions,
+                 .bus_us = stats.bus_time_ns / 1000.0,
+                 .busy_wait_us = busy_wait_us};
+}
+
+/// The driver before batching: SetCursor sent the address, every character
+/// was its own START/address/control/data/STOP, each followed by a 27us
+/// busy wait
+class LegacyLcd final {
+ public:
+  static constexpr double kDelayUs = 27;
+
+  explicit LegacyLcd(i2c_master_bus_handle_t bus) : dev_(nullptr) {
+    i2c_device_config_t config = {};
+    config.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+    config.device_address = ST7032::kI2cDefaultAddr;
+    config.scl_speed_hz = ST7032::kI2cStandardModeHz;
+    i2c_master_bus_add_device(bus, &config, &dev_);
+  }
+  ~LegacyLcd() { i2c_master_bus_rm_device(dev_); }
+
+  /// Returns the busy wait [us]
+  double Draw(const search_view::Frame& frame) {
+    static constexpr uint8_t kRowOffsets[] = {0x00, 0x40};
+    double busy_wait_us = 0;
+    for (size_t line = 0; line < search_view::kLcdLines; ++line) {
+      const uint8_t command[] = {0x00, static_cast<uint8_t>(
+                                           ST7032::kLcdSetDDRRamAddr |
+                                           kRowOffsets[line])};
+      i2c_master_transmit(dev_, command, sizeof(command), -1);
+      busy_wait_us += kDelayUs;
+      for (size_t col = 0; col < search_view::kLcdCols; ++col) {
+        const uint8_t data[] = {0x40, frame.rows[line][col]};
+        i2c_master_transmit(dev_, data, sizeof(data), -1);
+        busy_wait_us += kDelayUs;
+      }
+    }
+    return busy_wait_us;
+  }
+
+ private:
+  i2c_master_dev_handle_t dev_;
+};
+
+BleBeaconItem MakeItem(const uint16_t minor, const int32_t rssi,
+                       const uint32_t distance_cm,
+                       const RssiTrend::Direction trend) {
+  BleBeaconItem item = {};
+  item.minor = minor;
+  item.rssi = rssi;
+  item.distance_cm = distance_cm;
+  item.trend = trend;
+  return item;
+}
+
+bool IsShown(const sim::LcdModel& model, const search_view::Frame& frame) {
+  for (size_t line = 0; line < search_view::kLcdLines; ++line) {
+    const std::string expected(reinterpret_cast<const char*>(frame.rows[line]),
+                               search_view::kLcdCols);
+    if (model.GetLine(line, search_view::kLcdCols) != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PrintRow(const char* const name, const Traffic& before,
+              const Traffic& after) {
+  std::printf("%-20s %4u/%-4u %4u/%-4u %7.0f/%-7.0f %5.0f/%.0f\n", name,
+              before.transactions, after.transactions, before.wire_bytes,
+              after.wire_bytes, before.bus_us, after.bus_us,
+              before.busy_wait_us, after.busy_wait_us);
+}
+
+}  // namespace
+
+int main() {
+  std::unique_ptr<HostI2cBus, void (*)(i2c_master_bus_handle_t)> bus(
+      i2c_sim::CreateBus(), &i2c_sim::DeleteBus);
+  std::unique_ptr<HostI2cBus, void (*)(i2c_master_bus_handle_t)> legacy_bus(
+      i2c_sim::CreateBus(), &i2c_sim::DeleteBus);
+  sim::LcdModel model(bus.get(), ST7032::kI2cDefaultAddr);
+  sim::LcdModel legacy_model(legacy_bus.get(), ST7032::kI2cDefaultAddr);
+
+  ST7032 lcd;
+  lcd.Setup(bus.get(), ST7032::kI2cDefaultAddr, search_view::kLcdCols,
+            search_view::kLcdLines);
+  LegacyLcd legacy_lcd(legacy_bus.get());
+
+  // Search screen frames as a hunt goes: first beacon, both beacons, the
+  // bar of one moves a cell, the order swaps, unchanged, all lost
+  const RssiTrend::Direction kSteady = RssiTrend::Direction::kSteady;
+  const RssiTrend::Direction kApproaching = RssiTrend::Direction::kApproaching;
+  struct Step {
+    const char* name;
+    RankedItems items;
+  };
+  const Step steps[] = {
+      {"first beacon", {1, {MakeItem(7, -78, 1260, kSteady)}}},
+      {"two beacons",
+       {2, {MakeItem(7, -78, 1260, kSteady), MakeItem(3, -85, 2510, kSteady)}}},
+      {"bar +1 cell",
+       {2,
+        {MakeItem(7, -68, 1260, kApproaching),
+         MakeItem(3, -85, 2510, kSteady)}}},
+      {"order swap",
+       {2,
+        {MakeItem(3, -60, 420, kApproaching),
+         MakeItem(7, -68, 1260, kSteady)}}},
+      {"unchanged",
+       {2,
+        {MakeItem(3, -60, 420, kApproaching),
+         MakeItem(7, -68, 1260, kSteady)}}},
+      {"no signal", {0, {}}},
+  };
+
+  std::printf("%-20s %9s %9s %15s %s\n", "frame (before/after)", "trans",
+              "bytes", "bus[us]", "busy[us]");
+  Traffic total_before = {};
+  Traffic total_after = {};
+  for (const Step& step : steps) {
+    search_view::Frame frame;
+    search_view::Render(step.items, &frame);
+
+    i2c_sim::ResetStats(bus.get());
+    for (uint8_t line = 0; line < search_view::kLcdLines; ++line) {
+      lcd.SetCursor(0, line);
+      lcd.Write(frame.rows[line], search_view::kLcdCols);
+    }
+    const Traffic after = GetTraffic(bus.get(), 0);
+
+    i2c_sim::ResetStats(legacy_bus.get());
+    const double busy_wait_us = legacy_lcd.Draw(frame);
+    const Traffic before = GetTraffic(legacy_bus.get(), busy_wait_us);
+
+    PrintRow(step.name, before, after);
+    CHECK(IsShown(model, frame));
+    CHECK(IsShown(legacy_model, frame));
+    // Per-character driver: 2 addresses + 32 characters, 3 bytes each
+    CHECK(before.transactions == 34 && before.wire_bytes == 102);
+    CHECK(after.transactions < before.transactions / 2);
+    CHECK(after.wire_bytes < before.wire_bytes / 2);
+
+    total_before.transactions += before.transactions;
+    total_before.wire_bytes += before.wire_bytes;
+    total_before.bus_us += before.bus_us;
+    total_before.busy_wait_us += before.busy_wait_us;
+    total_after.transactions += after.transactions;
+    total_after.wire_bytes += after.wire_bytes;
+    total_after.bus_us += after.bus_us;
+  }
+  PrintRow("total", total_before, total_after);
+
+  // Drawing the screen shown again sends nothing
+  {
+    search_view::Frame frame;
+    search_view::Render(steps[sizeof(steps) / sizeof(steps[0]) - 1].items,
+                        &frame);
+    i2c_sim::ResetStats(bus.get());
+    for (uint8_t line = 0; line < search_view::kLcdLines; ++line) {
+      lcd.SetCursor(0, line);
+      lcd.Write(frame.rows[line], search_view::kLcdCols);
+    }
+    CHECK(i2c_sim::GetStats(bus.get()).transactions == 0);
+  }
+
+  // Data runs stay within the controller's RAM write time (27us per byte)
+  ST7032 fast_lcd;
+  fast_lcd.Attach(bus.get(), 0x3F, search_view::kLcdCols,
+                  search_view::kLcdLines, ST7032::kLcd5x8dots,
+                  ST7032::kI2cFastModeHz);
+  CHECK(fast_lcd.IsAttached());
+  i2c_sim::ResetStats(bus.get());
+  fast_lcd.SetCursor(0, 0);
+  fast_lcd.Print("0123456789ABCDEF");
+  const i2c_sim::BusStats& stats = i2c_sim::GetStats(bus.get());
+  const double clocks = stats.transactions * 11.0 + stats.bytes * 9.0;
+  CHECK(stats.transactions == 2);
+  CHECK(9 * (stats.bus_time_ns / clocks) >= 27000 - 1);
+
+  std::printf("driver counters: %lu transactions, %lu bytes\n",
+              static_cast<unsigned long>(lcd.GetTransactionCount()),
+              static_cast<unsigned long>(lcd.GetTransferredBytes()));
+  return test_check::TestResult();
+}
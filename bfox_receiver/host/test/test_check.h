@@ -0,0 +1,40 @@
+#ifndef BFOX_RECEIVER_HOST_TEST_TEST_CHECK_H_
+#define BFOX_RECEIVER_HOST_TEST_TEST_CHECK_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Minimal checks for the host tests (no framework), main returns
+// TestResult()
+
+// Include ----------------------
+#include <cstdio>
+
+namespace test_check {
+
+inline int failure_count = 0;
+
+inline void Fail(const char* const file, const int line,
+                 const char* const expression) {
+  std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expression);
+  ++failure_count;
+}
+
+inline int TestResult() {
+  if (failure_count != 0) {
+    std::fprintf(stderr, "%d check(s) failed\n", failure_count);
+    return 1;
+  }
+  std::printf("OK\n");
+  return 0;
+}
+
+}  // namespace test_check
+
+// Variadic, so template argument lists need no extra parentheses
+#define CHECK(...)                                     \
+  do {                                                 \
+    if (!(__VA_ARGS__)) {                              \
+      test_check::Fail(__FILE__, __LINE__, #__VA_ARGS__); \
+    }                                                  \
+  } while (0)
+
+#endif  // BFOX_RECEIVER_HOST_TEST_TEST_CHECK_H_
@@ -0,0 +1,135 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "scan_trace_reader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace bfox_receiver_system {
+namespace scan_trace {
+
+namespace {
+
+using FilePtr = std::unique_ptr<FILE, int (*)(FILE*)>;
+
+}  // namespace
+
+bool Read(const std::string& path, Trace* const trace,
+          std::string* const error) {
+  FilePtr file(std::fopen(path.c_str(), "rb"), &std::fclose);
+  if (!file) {
+    *error = "cannot open " + path;
+    return false;
+  }
+
+  ScanTraceHeader& header = trace->header;
+  if (std::fread(&header, sizeof(header), 1, file.get()) != 1 ||
+      std::memcmp(header.magic, kMagic, sizeof(header.magic)) != 0) {
+    *error = path + " is not a scan trace";
+    return false;
+  }
+  if (header.version != kVersion ||
+      header.record_size != sizeof(ScanTraceRecord)) {
+    *error = path + ": unsupported version " + std::to_string(header.version);
+    return false;
+  }
+
+  trace->records.clear();
+  trace->time_gap_count = 0;
+  int64_t time_ms = header.start_ms;
+  ScanTraceRecord record;
+  while (std::fread(&record, sizeof(record), 1, file.get()) == 1) {
+    time_ms += record.dt_ms;
+    if (record.group == kTimeGapGroup) {
+      ++trace->time_gap_count;
+      continue;
+    }
+    trace->records.push_back(
+        {.timestamp_ms = static_cast<uint32_t>(time_ms),
+         .minor = record.minor,
+         .rssi = record.rssi,
+         .measured_power = record.measured_power,
+         .group = record.group});
+  }
+  trace->end_ms = time_ms;
+  return true;
+}
+
+bool Write(const std::string& path, const uint32_t start_ms,
+           const std::vector<ScanRecord>& records) {
+  FilePtr file(std::fopen(path.c_str(), "wb"), &std::fclose);
+  if (!file) {
+    return false;
+  }
+  ScanTraceHeader header = {.version = kVersion,
+                            .record_size = sizeof(ScanTraceRecord),
+                            .reserved = 0,
+                            .start_ms = start_ms};
+  std::memcpy(header.magic, kMagic, sizeof(header.magic));
+  bool written = std::fwrite(&header, sizeof(header), 1, file.get()) == 1;
+
+  uint32_t last_timestamp_ms = start_ms;
+  for (const ScanRecord& record : records) {
+    uint32_t dt_ms = record.timestamp_ms - last_timestamp_ms;
+    last_timestamp_ms = record.timestamp_ms;
+    const ScanTraceRecord gap = {.dt_ms = UINT16_MAX,
+                                 .group = kTimeGapGroup,
+                                 .channel = kUnknownChannel};
+    for (; dt_ms > UINT16_MAX; dt_ms -= UINT16_MAX) {
+      written &= std::fwrite(&gap, sizeof(gap), 1, file.get()) == 1;
+    }
+    const ScanTraceRecord trace_record = {
+        .dt_ms = static_cast<uint16_t>(dt_ms),
+        .minor = record.minor,
+        .rssi = record.rssi,
+        .measured_power = record.measured_power,
+        .group = record.group,
+        .channel = kUnknownChannel};
+    written &=
+        std::fwrite(&trace_record, sizeof(trace_record), 1, file.get()) == 1;
+  }
+  return written;
+}
+
+void Replay(const Trace& trace, const ReplayOptions& options,
+            const ViewChangeCallback& on_view_change) {
+  // Records carry a group index only; the UUID and major are not needed
+  BeaconGroup groups[BeaconTracker::kMaxGroupNum] = {};
+  for (size_t group = 0; group < BeaconTracker::kMaxGroupNum; ++group) {
+    groups[group].major = static_cast<uint16_t>(group);
+  }
+  BeaconTracker tracker(groups, BeaconTracker::kMaxGroupNum);
+
+  BeaconTracker::RankedItems shown = {};
+  const auto publish = [&](const int64_t time_ms) {
+    BeaconTracker::RankedItems ranked_items;
+    tracker.GetRankedItems(options.group, &ranked_items);
+    if (BeaconTracker::IsViewChanged(shown, ranked_items)) {
+      shown = ranked_items;
+      on_view_change(time_ms, ranked_items);
+    }
+  };
+
+  for (const ScanRecord& record : trace.records) {
+    const int64_t now_ms = record.timestamp_ms;
+    if (tracker.RemoveExpired(now_ms) & (1u << options.group)) {
+      publish(now_ms);
+    }
+    if (tracker.Update(record, now_ms, options.rssi_filter_mode,
+                       options.path_loss_exponent_x10) &&
+        record.group == options.group) {
+      publish(now_ms);
+    }
+  }
+  // Everything still shown expires after the last record
+  const int64_t expiry_ms = trace.end_ms + BeaconTracker::kBeaconExpiryMs + 1;
+  if (tracker.RemoveExpired(expiry_ms) & (1u << options.group)) {
+    publish(expiry_ms);
+  }
+}
+
+}  // namespace scan_trace
+}  // namespace bfox_receiver_system
@@ -0,0 +1,57 @@
+#ifndef BFOX_RECEIVER_HOST_TOOLS_SCAN_TRACE_READER_H_
+#define BFOX_RECEIVER_HOST_TOOLS_SCAN_TRACE_READER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Reads scanNNN.bin traces (scan_trace_format.h) and replays them into
+// BeaconTracker
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "beacon_tracker.h"
+#include "scan_record.h"
+#include "scan_trace_format.h"
+
+namespace bfox_receiver_system {
+namespace scan_trace {
+
+struct Trace {
+  ScanTraceHeader header;
+  std::vector<ScanRecord> records;  // absolute timestamps
+  uint32_t time_gap_count;
+  int64_t end_ms;  // last record
+};
+
+/// Returns false with a message on a file that is not a trace. A partial
+/// last record (power lost mid-write) is ignored.
+bool Read(const std::string& path, Trace* const trace,
+          std::string* const error);
+
+/// Encode records as ScanTraceRecorder does (for tests and converters)
+bool Write(const std::string& path, const uint32_t start_ms,
+           const std::vector<ScanRecord>& records);
+
+struct ReplayOptions {
+  size_t group;  // ranking reported
+  RssiFilterMode rssi_filter_mode;
+  int32_t path_loss_exponent_x10;
+};
+
+using ViewChangeCallback = std::function<void(
+    const int64_t time_ms, const BeaconTracker::RankedItems& ranked_items)>;
+
+/// Feed the records to BeaconTracker in order, expiring entries at each
+/// record time, and report every view change of options.group. The
+/// receive task drains in kDrainIntervalMs batches; replay applies each
+/// record at its own time.
+void Replay(const Trace& trace, const ReplayOptions& options,
+            const ViewChangeCallback& on_view_change);
+
+}  // namespace scan_trace
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_HOST_TOOLS_SCAN_TRACE_READER_H_
@@ -0,0 +1,184 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Replays a scan trace recorded by the receiver (storage partition,
+// scanNNN.bin) through the RSSI filter and ranking code and prints how the
+// search screen ranking evolves.
+//
+// Usage: scan_trace_replay [--group N] [--filter raw|ema|kalman|median]
+//                          [--csv DIR] scanNNN.bin
+// --csv writes DIR/g<group>_m<minor>.csv ("time_ms,rssi", raw) per beacon,
+// the input format of rssi_filter_replay_test.
+
+// Include ----------------------
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "beacon_receive_task.h"
+#include "distance_estimator.h"
+#include "scan_trace_reader.h"
+
+using namespace bfox_receiver_system;
+
+namespace {
+
+struct FilterName {
+  const char* name;
+  RssiFilterMode mode;
+};
+
+constexpr FilterName kFilterNames[] = {
+    {"raw", RssiFilterMode::kRaw},
+    {"ema", RssiFilterMode::kEma},
+    {"kalman", RssiFilterMode::kKalman},
+    {"median", RssiFilterMode::kMedian},
+};
+
+char TrendMark(const RssiTrend::Direction trend) {
+  switch (trend) {
+    case RssiTrend::Direction::kApproaching:
+      return '^';
+    case RssiTrend::Direction::kReceding:
+      return 'v';
+    case RssiTrend::Direction::kSteady:
+      return '-';
+    case RssiTrend::Direction::kUnknown:
+    default:
+      return ' ';
+  }
+}
+
+void PrintUsage() {
+  std::fprintf(stderr,
+               "usage: scan_trace_replay [--group N] "
+               "[--filter raw|ema|kalman|median] [--csv DIR] scanNNN.bin\n");
+}
+
+bool WriteCsv(const std::string& directory, const scan_trace::Trace& trace) {
+  using Key = std::pair<uint8_t, uint16_t>;  // group, minor
+  std::map<Key, FILE*> files;
+  bool written = true;
+  for (const ScanRecord& record : trace.records) {
+    const Key key(record.group, record.minor);
+    auto it = files.find(key);
+    if (it == files.end()) {
+      const std::string path = directory + "/g" +
+                               std::to_string(record.group) + "_m" +
+                               std::to_string(record.minor) + ".csv";
+      FILE* const file = std::fopen(path.c_str(), "w");
+      if (file == nullptr) {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        written = false;
+        break;
+      }
+      std::fprintf(file, "# group %u minor %u\n# time_ms,rssi\n",
+                   record.group, record.minor);
+      it = files.emplace(key, file).first;
+    }
+    std::fprintf(it->second, "%lld,%d\n",
+                 static_cast<long long>(record.timestamp_ms) -
+                     trace.header.start_ms,
+                 record.rssi);
+  }
+  for (const auto& entry : files) {
+    std::fclose(entry.second);
+  }
+  if (written) {
+    std::printf("%zu beacon CSV files in %s\n", files.size(),
+                directory.c_str());
+  }
+  return written;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  scan_trace::ReplayOptions options = {
+      .group = 0,
+      .rssi_filter_mode = BeaconReceiveTask::kDefaultRssiFilterMode,
+      .path_loss_exponent_x10 =
+          distance_estimator::kDefaultPathLossExponentX10};
+  std::string csv_directory;
+  std::string path;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--group" && i + 1 < argc) {
+      options.group = std::strtoul(argv[++i], nullptr, 10);
+    } else if (arg == "--filter" && i + 1 < argc) {
+      const char* const name = argv[++i];
+      bool found = false;
+      for (const FilterName& filter : kFilterNames) {
+        if (std::strcmp(filter.name, name) == 0) {
+          options.rssi_filter_mode = filter.mode;
+          found = true;
+        }
+      }
+      if (!found) {
+        PrintUsage();
+        return 2;
+      }
+    } else if (arg == "--csv" && i + 1 < argc) {
+      csv_directory = argv[++i];
+    } else if (path.empty() && arg[0] != '-') {
+      path = arg;
+    } else {
+      PrintUsage();
+      return 2;
+    }
+  }
+  if (path.empty() || options.group >= BeaconTracker::kMaxGroupNum) {
+    PrintUsage();
+    return 2;
+  }
+
+  scan_trace::Trace trace;
+  std::string error;
+  if (!scan_trace::Read(path, &trace, &error)) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+    return 1;
+  }
+
+  std::map<uint16_t, uint32_t> counts;  // minor -> records, of the group
+  for (const ScanRecord& record : trace.records) {
+    if (record.group == options.group) {
+      ++counts[record.minor];
+    }
+  }
+  std::printf("%s: %zu records, %u time gaps, %.1fs\n", path.c_str(),
+              trace.records.size(), trace.time_gap_count,
+              (trace.end_ms - trace.header.start_ms) / 1000.0);
+  std::printf("group %zu:", options.group);
+  for (const auto& count : counts) {
+    std::printf(" %u(%u)", count.first, count.second);
+  }
+  std::printf("\n\n");
+
+  // One line per search screen change: time, then the ranked beacons
+  uint32_t change_count = 0;
+  scan_trace::Replay(
+      trace, options,
+      [&](const int64_t time_ms,
+          const BeaconTracker::RankedItems& ranked_items) {
+        ++change_count;
+        std::printf("%9.3fs", (time_ms - trace.header.start_ms) / 1000.0);
+        if (ranked_items.count == 0) {
+          std::printf("  NO SIGNAL");
+        }
+        for (size_t i = 0; i < ranked_items.count; ++i) {
+          const BleBeaconItem& item = ranked_items.items[i];
+          std::printf("  %c%5u %4lddBm %6.1fm %c", (i == 0) ? ' ' : '|',
+                      item.minor, static_cast<long>(item.rssi),
+                      item.distance_cm / 100.0, TrendMark(item.trend));
+        }
+        std::printf("\n");
+      });
+  std::printf("\n%u screen changes\n", change_count);
+
+  if (!csv_directory.empty() && !WriteCsv(csv_directory, trace)) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,169 @@
+#ifndef BFOX_RECEIVER_MAIN_AD_PARSER_H_
+#define BFOX_RECEIVER_MAIN_AD_PARSER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Advertising data (AD structure) parser and beacon frame decoders
+
+// Include ----------------------
+#include <cstdint>
+#include <cstring>
+
+namespace bfox_receiver_system {
+
+/// One AD structure [length][type][data...], pointing into the advertisement
+struct AdStructure {
+  uint8_t type;
+  const uint8_t* data;
+  uint8_t length;  // data length (without type)
+};
+
+/// Non-allocating iterator over the AD structures of an advertisement
+class AdStructureIterator final {
+ public:
+  static constexpr uint8_t kTypeFlags = 0x01;
+  static constexpr uint8_t kTypeServiceData16 = 0x16;
+  static constexpr uint8_t kTypeManufacturerData = 0xFF;
+
+ public:
+  AdStructureIterator(const uint8_t* const data, const uint8_t length)
+      : data_(data), length_(data != nullptr ? length : 0), offset_(0) {}
+
+  bool Next(AdStructure* const ad) {
+    while (offset_ < length_) {
+      const uint8_t field_length = data_[offset_];
+      if (field_length == 0) {
+        return false;  // padding, end of significant part
+      }
+      if (length_ - offset_ - 1 < field_length) {
+        return false;  // truncated
+      }
+      ad->type = data_[offset_ + 1];
+      ad->data = &data_[offset_ + 2];
+      ad->length = field_length - 1;
+      offset_ += field_length + 1;
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  const uint8_t* data_;
+  uint8_t length_;
+  uint8_t offset_;
+};
+
+enum class BeaconFormat : uint8_t {
+  kIBeacon,
+  kAltBeacon,
+  kEddystoneUid,
+  kEddystoneTlm,
+};
+
+/// Decoded beacon frame
+struct BeaconFrame {
+  BeaconFormat format;
+  // iBeacon: proximity UUID, AltBeacon: beacon id 1-16,
+  // Eddystone-UID: namespace(10) + instance(6)
+  uint8_t uuid[16];
+  uint16_t major;
+  uint16_t minor;
+  int8_t measured_power;  // RSSI @1m [dBm]
+  // Eddystone-TLM
+  uint16_t battery_mv;
+  int16_t temperature_x256;  // 8.8 fixed point [C]
+};
+
+namespace ad_decoder {
+
+inline uint16_t ReadU16BigEndian(const uint8_t* const data) {
+  return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+/// Apple iBeacon: manufacturer data 4C 00 02 15 [uuid 16][major][minor][power]
+struct IBeacon {
+  static bool Decode(const AdStructure& ad, BeaconFrame* const frame) {
+    if (ad.type != AdStructureIterator::kTypeManufacturerData ||
+        ad.length != 25 || ad.data[0] != 0x4C || ad.data[1] != 0x00 ||
+        ad.data[2] != 0x02 || ad.data[3] != 0x15) {
+      return false;
+    }
+    frame->format = BeaconFormat::kIBeacon;
+    std::memcpy(frame->uuid, &ad.data[4], sizeof(frame->uuid));
+    frame->major = ReadU16BigEndian(&ad.data[20]);
+    frame->minor = ReadU16BigEndian(&ad.data[22]);
+    frame->measured_power = static_cast<int8_t>(ad.data[24]);
+    return true;
+  }
+};
+
+/// AltBeacon: manufacturer data [mfg id 2] BE AC [beacon id 20][ref rssi][rsv]
+struct AltBeacon {
+  static bool Decode(const AdStructure& ad, BeaconFrame* const frame) {
+    if (ad.type != AdStructureIterator::kTypeManufacturerData ||
+        ad.length != 26 || ad.data[2] != 0xBE || ad.data[3] != 0xAC) {
+      return false;
+    }
+    frame->format = BeaconFormat::kAltBeacon;
+    std::memcpy(frame->uuid, &ad.data[4], sizeof(frame->uuid));
+    frame->major = ReadU16BigEndian(&ad.data[20]);
+    frame->minor = ReadU16BigEndian(&ad.data[22]);
+    frame->measured_power = static_cast<int8_t>(ad.data[24]);
+    return true;
+  }
+};
+
+/// Eddystone: service data AA FE [frame type]...
+struct EddystoneUid {
+  static bool Decode(const AdStructure& ad, BeaconFrame* const frame) {
+    // AA FE 00 [tx power @0m][namespace 10][instance 6]([rfu 2])
+    if (ad.type != AdStructureIterator::kTypeServiceData16 || ad.length < 20 ||
+        ad.data[0] != 0xAA || ad.data[1] != 0xFE || ad.data[2] != 0x00) {
+      return false;
+    }
+    constexpr int8_t kTxPowerLossAt1m = 41;
+    frame->format = BeaconFormat::kEddystoneUid;
+    std::memcpy(frame->uuid, &ad.data[4], sizeof(frame->uuid));
+    frame->major = 0;
+    frame->minor = 0;
+    frame->measured_power =
+        static_cast<int8_t>(static_cast<int8_t>(ad.data[3]) - kTxPowerLossAt1m);
+    return true;
+  }
+};
+
+struct EddystoneTlm {
+  static bool Decode(const AdStructure& ad, BeaconFrame* const frame) {
+    // AA FE 20 [version 00][vbatt 2][temp 2][adv cnt 4][sec cnt 4]
+    if (ad.type != AdStructureIterator::kTypeServiceData16 || ad.length != 16 ||
+        ad.data[0] != 0xAA || ad.data[1] != 0xFE || ad.data[2] != 0x20 ||
+        ad.data[3] != 0x00) {
+      return false;
+    }
+    frame->format = BeaconFormat::kEddystoneTlm;
+    frame->battery_mv = ReadU16BigEndian(&ad.data[4]);
+    frame->temperature_x256 =
+        static_cast<int16_t>(ReadU16BigEndian(&ad.data[6]));
+    return true;
+  }
+};
+
+}  // namespace ad_decoder
+
+/// Decode the first AD structure accepted by one of Decoders (tried in order,
+/// resolved at compile time).
+template <typename... Decoders>
+bool ParseBeaconFrame(const uint8_t* const data, const uint8_t length,
+                      BeaconFrame* const frame) {
+  AdStructureIterator iterator(data, length);
+  AdStructure ad;
+  while (iterator.Next(&ad)) {
+    if ((Decoders::Decode(ad, frame) || ...)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_AD_PARSER_H_
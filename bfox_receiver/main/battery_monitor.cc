@@ -0,0 +1,236 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "battery_monitor.h"
+
+#include <esp_adc/adc_cali_scheme.h>
+#include <esp_adc/adc_filter.h>
+
+#include <iterator>
+
+#include "logger.h"
+
+namespace bfox_receiver_system {
+
+namespace {
+
+constexpr adc_unit_t kAdcUnit = ADC_UNIT_1;
+constexpr adc_atten_t kAdcAtten = ADC_ATTEN_DB_12;
+constexpr uint32_t kFrameSize =
+    BatteryMonitor::kFrameSampleNum * SOC_ADC_DIGI_RESULT_BYTES;
+
+/// Open circuit voltage of a Li-ion cell [mV] to state of charge [%]
+struct SocPoint {
+  uint16_t voltage_mv;
+  uint8_t percent;
+};
+constexpr SocPoint kSocCurve[] = {
+    {3200, 0},  {3300, 1},  {3400, 3},  {3500, 7},   {3600, 15}, {3700, 30},
+    {3800, 50}, {3900, 65}, {4000, 78}, {4100, 90},  {4200, 100},
+};
+
+}  // namespace
+
+BatteryMonitor::BatteryMonitor(const adc_channel_t channel,
+                               const uint32_t divider_ratio)
+    : channel_(channel),
+      divider_ratio_(divider_ratio),
+      handle_(nullptr),
+      cali_handle_(nullptr),
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED
+      iir_filter_(nullptr),
+#endif
+      ready_(nullptr),
+      filtered_raw_(0),
+      frame_count_(0) {}
+
+BatteryMonitor::~BatteryMonitor() {
+  Stop();
+  if (handle_ != nullptr) {
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED
+    if (iir_filter_ != nullptr) {
+      adc_del_continuous_iir_filter(iir_filter_);
+    }
+#endif
+    adc_continuous_deinit(handle_);
+  }
+  if (cali_handle_ != nullptr) {
+    adc_cali_delete_scheme_curve_fitting(cali_handle_);
+  }
+  if (ready_ != nullptr) {
+    vSemaphoreDelete(ready_);
+  }
+}
+
+bool BatteryMonitor::Start() {
+  if (handle_ != nullptr) {
+    return adc_continuous_start(handle_) == ESP_OK;
+  }
+
+  ready_ = xSemaphoreCreateBinary();
+  if (ready_ == nullptr) {
+    ESP_LOGE(kTag, "Battery monitor semaphore failed");
+    return false;
+  }
+
+  // Calibration is created once and reused for every reading
+  const adc_cali_curve_fitting_config_t cali_config = {
+      .unit_id = kAdcUnit,
+      .chan = channel_,
+      .atten = kAdcAtten,
+      .bitwidth = ADC_BITWIDTH_DEFAULT,
+  };
+  esp_err_t ret =
+      adc_cali_create_scheme_curve_fitting(&cali_config, &cali_handle_);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "ADC calibration failed: %s", esp_err_to_name(ret));
+    cali_handle_ = nullptr;
+    return false;
+  }
+
+  const adc_continuous_handle_cfg_t handle_config = {
+      .max_store_buf_size = kFrameSize * 2,
+      .conv_frame_size = kFrameSize,
+  };
+  ret = adc_continuous_new_handle(&handle_config, &handle_);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "ADC continuous handle failed: %s", esp_err_to_name(ret));
+    handle_ = nullptr;
+    return false;
+  }
+
+  adc_digi_pattern_config_t pattern = {
+      .atten = kAdcAtten,
+      .channel = static_cast<uint8_t>(channel_),
+      .unit = kAdcUnit,
+      .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+  };
+  const adc_continuous_config_t config = {
+      .pattern_num = 1,
+      .adc_pattern = &pattern,
+      .sample_freq_hz = kSampleFreqHz,
+      .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+      .format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+  };
+  ESP_ERROR_CHECK(adc_continuous_config(handle_, &config));
+
+#if SOC_ADC_DIG_IIR_FILTER_SUPPORTED
+  // Hardware averaging before the samples reach DMA
+  const adc_continuous_iir_filter_config_t filter_config = {
+      .unit = kAdcUnit,
+      .channel = channel_,
+      .coeff = ADC_DIGI_IIR_FILTER_COEFF_16,
+  };
+  if (adc_new_continuous_iir_filter(handle_, &filter_config, &iir_filter_) ==
+      ESP_OK) {
+    adc_continuous_iir_filter_enable(iir_filter_);
+  } else {
+    iir_filter_ = nullptr;
+  }
+#endif
+
+  const adc_continuous_evt_cbs_t callbacks = {
+      .on_conv_done = &BatteryMonitor::OnConvDone,
+      .on_pool_ovf = nullptr,
+  };
+  ESP_ERROR_CHECK(
+      adc_continuous_register_event_callbacks(handle_, &callbacks, this));
+
+  return adc_continuous_start(handle_) == ESP_OK;
+}
+
+void BatteryMonitor::Stop() {
+  if (handle_ != nullptr) {
+    adc_continuous_stop(handle_);
+  }
+}
+
+bool BatteryMonitor::WaitReady(const uint32_t timeout_ms) {
+  if (frame_count_.load(std::memory_order_acquire) != 0) {
+    return true;
+  }
+  if (ready_ == nullptr) {
+    return false;
+  }
+  return xSemaphoreTake(ready_, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+uint32_t BatteryMonitor::GetVoltageMv() const {
+  if (frame_count_.load(std::memory_order_acquire) == 0 ||
+      cali_handle_ == nullptr) {
+    return 0;
+  }
+  const uint32_t filtered_raw = filtered_raw_.load(std::memory_order_relaxed);
+  int adc_voltage_mv = 0;
+  const int raw = static_cast<int>(
+      (filtered_raw + (1u << (kFilterShift - 1))) >> kFilterShift);
+  if (adc_cali_raw_to_voltage(cali_handle_, raw, &adc_voltage_mv) != ESP_OK) {
+    return 0;
+  }
+  return static_cast<uint32_t>(adc_voltage_mv) * divider_ratio_;
+}
+
+uint8_t BatteryMonitor::GetStateOfCharge() const {
+  return EstimateStateOfCharge(GetVoltageMv());
+}
+
+uint8_t BatteryMonitor::EstimateStateOfCharge(const uint32_t voltage_mv) {
+  if (voltage_mv <= kSocCurve[0].voltage_mv) {
+    return 0;
+  }
+  for (size_t i = 1; i < std::size(kSocCurve); ++i) {
+    const SocPoint& high = kSocCurve[i];
+    if (voltage_mv < high.voltage_mv) {
+      // Linear between the curve points
+      const SocPoint& low = kSocCurve[i - 1];
+      return low.percent + (voltage_mv - low.voltage_mv) *
+                               (high.percent - low.percent) /
+                               (high.voltage_mv - low.voltage_mv);
+    }
+  }
+  return 100;
+}
+
+bool BatteryMonitor::OnConvDone(adc_continuous_handle_t handle,
+                                const adc_continuous_evt_data_t* event_data,
+                                void* user_data) {
+  BatteryMonitor* const self = static_cast<BatteryMonitor*>(user_data);
+
+  // Average the frame (one channel, no allocation)
+  uint32_t sum = 0;
+  uint32_t count = 0;
+  for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= event_data->size;
+       i += SOC_ADC_DIGI_RESULT_BYTES) {
+    const adc_digi_output_data_t* const result =
+        reinterpret_cast<const adc_digi_output_data_t*>(
+            &event_data->conv_frame_buffer[i]);
+    if (result->type2.channel == self->channel_) {
+      sum += result->type2.data;
+      ++count;
+    }
+  }
+  if (count == 0) {
+    return false;
+  }
+  const uint32_t frame_raw = (sum << kFilterShift) / count;
+
+  if (self->frame_count_.load(std::memory_order_relaxed) == 0) {
+    // First frame seeds the filter
+    self->filtered_raw_.store(frame_raw, std::memory_order_relaxed);
+    self->frame_count_.store(1, std::memory_order_release);
+    BaseType_t high_task_wakeup = pdFALSE;
+    xSemaphoreGiveFromISR(self->ready_, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+  }
+  const int32_t filtered_raw =
+      self->filtered_raw_.load(std::memory_order_relaxed);
+  self->filtered_raw_.store(
+      filtered_raw +
+          ((static_cast<int32_t>(frame_raw) - filtered_raw) >> kFilterShift),
+      std::memory_order_relaxed);
+  self->frame_count_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,19 @@
+#ifndef BFOX_RECEIVER_MAIN_BEACON_GROUP_H_
+#define BFOX_RECEIVER_MAIN_BEACON_GROUP_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Target beacons of one course, identified by (proximity UUID, major)
+struct BeaconGroup {
+  uint8_t proximity_uuid[16];
+  uint16_t major;
+  uint16_t adv_interval_ms;  // slowest beacon of the course, 0: unknown
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_BEACON_GROUP_H_
@@ -0,0 +1,120 @@
+#ifndef BFOX_RECEIVER_MAIN_BEACON_RANKING_H_
+#define BFOX_RECEIVER_MAIN_BEACON_RANKING_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+#include "beacon_table.h"
+#include "ble_beacon_item.h"
+
+namespace bfox_receiver_system {
+
+/// Top-K beacons ordered by RSSI (strongest first), maintained incrementally
+/// as beacon table entries are updated.
+template <size_t kTopK>
+class BeaconRanking {
+ public:
+  static_assert(kTopK > 0, "kTopK must be positive");
+
+  /// Fixed-size copy of the ranking handed to the UI
+  struct Snapshot {
+    size_t count;
+    BleBeaconItem items[kTopK];
+  };
+
+ public:
+  BeaconRanking() : items_(), count_(0) {}
+
+  /// Reflect an updated table entry. Returns true if the ranking changed.
+  template <size_t kCapacity>
+  bool OnUpdate(const BleBeaconItem& item,
+                const BeaconTable<kCapacity>& table) {
+    const int index = IndexOf(item.minor);
+    if (index >= 0) {
+      const bool weakened = item.rssi < items_[index].rssi;
+      items_[index] = item;
+      if (weakened && table.Size() > count_) {
+        // An unranked beacon may now be stronger
+        Rebuild(table);
+      } else {
+        SiftFrom(index);
+      }
+      return true;
+    }
+
+    if (count_ < kTopK) {
+      items_[count_] = item;
+      SiftFrom(count_++);
+      return true;
+    }
+    if (items_[kTopK - 1].rssi < item.rssi) {
+      items_[kTopK - 1] = item;
+      SiftFrom(kTopK - 1);
+      return true;
+    }
+    return false;
+  }
+
+  /// Recompute from the whole table (used after removals)
+  template <size_t kCapacity>
+  void Rebuild(const BeaconTable<kCapacity>& table) {
+    count_ = 0;
+    table.ForEach([this](const BleBeaconItem& item) {
+      if (count_ < kTopK) {
+        items_[count_] = item;
+        SiftFrom(count_++);
+      } else if (items_[kTopK - 1].rssi < item.rssi) {
+        items_[kTopK - 1] = item;
+        SiftFrom(kTopK - 1);
+      }
+    });
+  }
+
+  void GetSnapshot(Snapshot* const snapshot) const {
+    snapshot->count = count_;
+    for (size_t i = 0; i < count_; ++i) {
+      snapshot->items[i] = items_[i];
+    }
+  }
+
+  size_t Size() const { return count_; }
+
+ private:
+  int IndexOf(const uint16_t minor) const {
+    for (size_t i = 0; i < count_; ++i) {
+      if (items_[i].minor == minor) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  /// Restore order after items_[index] changed (insertion step)
+  void SiftFrom(size_t index) {
+    while (0 < index && items_[index - 1].rssi < items_[index].rssi) {
+      Swap(index - 1, index);
+      --index;
+    }
+    while (index + 1 < count_ && items_[index].rssi < items_[index + 1].rssi) {
+      Swap(index, index + 1);
+      ++index;
+    }
+  }
+
+  void Swap(const size_t a, const size_t b) {
+    const BleBeaconItem tmp = items_[a];
+    items_[a] = items_[b];
+    items_[b] = tmp;
+  }
+
+ private:
+  BleBeaconItem items_[kTopK];
+  size_t count_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_BEACON_RANKING_H_
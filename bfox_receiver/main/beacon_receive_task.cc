@@ -8,12 +8,12 @@
 #include <freertos/FreeRTOS.h>
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstring>
 
-#include "gpio_control.h"
-#include "ibeacon.h"
+#include "distance_estimator.h"
 #include "logger.h"
-#include "util.h"
+#include "perf_counters.h"
 
 // NimBLE Includes
 #include "host/ble_hs.h"
@@ -25,20 +25,64 @@ namespace bfox_receiver_system {
 
 BeaconReceiveTask* BeaconReceiveTask::instance_ = nullptr;
 
-BeaconReceiveTask::BeaconReceiveTask(const uint8_t target_proximity_uuid[16],
-                                     const uint16_t target_major_id)
+// NimBLE host task
+static perf::Counter adv_received_counter("scan.adv_received");
+static perf::Counter adv_accepted_counter("scan.adv_accepted");
+static perf::Counter adv_rejected_counter("scan.adv_rejected");
+static perf::Counter scan_restart_counter("scan.restart");
+static perf::Histogram gap_event_histogram("scan.gap_event_us");
+// Receive task
+static perf::Histogram tracker_lock_wait_histogram("tracker.lock_wait_us");
+static perf::Histogram update_histogram("receive.update_us");
+
+BeaconReceiveTask::BeaconReceiveTask(const BeaconGroup* const groups,
+                                     const size_t group_num,
+                                     const size_t active_group,
+                                     const RssiFilterMode rssi_filter_mode)
     : Task(kTaskName, kPriority, kCoreId),
-      beacon_items_mutex_(),
-      ble_beacon_items_(),
-      target_proximity_uuid_(),
-      target_major_id_(target_major_id) {
-  std::memcpy(target_proximity_uuid_, target_proximity_uuid,
-              sizeof(target_proximity_uuid_));
+      scan_ring_(),
+      drain_requested_(false),
+      reported_dropped_count_(0),
+      last_stats_log_ms_(0),
+      last_stack_log_ms_(0),
+      scan_filter_(),
+      scan_scheduler_(),
+      own_addr_type_(0),
+      tracker_mutex_(),
+      tracker_(groups, group_num),
+      published_group_(0),
+      active_group_(0),
+      group_occupancy_(),
+      scan_trace_recorder_(nullptr),
+      power_manager_(nullptr),
+      rssi_filter_mode_(rssi_filter_mode),
+      ranked_items_mutex_(),
+      ranked_items_(),
+      view_change_notify_task_(nullptr) {
+  if (group_num > kMaxGroupNum) {
+    ESP_LOGW(kTag, "Too many beacon groups: %zu (max %zu)", group_num,
+             kMaxGroupNum);
+  }
+  published_group_ = (active_group < tracker_.GetGroupNum()) ? active_group : 0;
+  active_group_ = published_group_;
+
+  // Every group is scanned for, the idle window must fit the slowest one
+  uint32_t adv_interval_ms = 0;
+  for (size_t group = 0; group < group_num; ++group) {
+    adv_interval_ms = std::max<uint32_t>(adv_interval_ms,
+                                         groups[group].adv_interval_ms);
+  }
+  scan_scheduler_.SetBeaconAdvIntervalMs(adv_interval_ms);
 }
 
 void BeaconReceiveTask::Initialize() {
   instance_ = this;
 
+  ESP_LOGI(kTag, "Beacon groups:%zu table capacity:%zu footprint:%zubytes",
+           tracker_.GetGroupNum(), BeaconTracker::BeaconItemTable::Capacity(),
+           BeaconTracker::BeaconItemTable::MemoryFootprint() *
+               tracker_.GetGroupNum());
+
   int rc = nimble_port_init();
   if (rc != 0) {
     ESP_LOGE(kTag, "nimble_port_init failed: %d", rc);
@@ -49,31 +93,213 @@ void BeaconReceiveTask::Initialize() {
   ble_hs_cfg.store_status_cb = ble_store_util_status_rr;
 
   nimble_port_freertos_init(HostTaskStatic);
+
+  // Entries restored on a warm resume expire as usual
+  std::scoped_lock lock(tracker_mutex_);
+  ScheduleExpiry(esp_timer_get_time() / 1000);
 }
 
-void BeaconReceiveTask::Update() { util::SleepMillisecond(2000); }
+void BeaconReceiveTask::Update() {
+  perf::ScopedTimer update_timer(&update_histogram);
+  // Records pushed from here on schedule the next drain
+  drain_requested_.store(false, std::memory_order_relaxed);
+  {
+    // The UI task takes the lock too (ForEachActiveItem, RestoreActiveItem)
+    const int64_t lock_start_us = esp_timer_get_time();
+    std::scoped_lock lock(tracker_mutex_);
+    tracker_lock_wait_histogram.Record(
+        static_cast<uint32_t>(esp_timer_get_time() - lock_start_us));
+    const bool drained = DrainScanRing();
+    const bool expired = RemoveExpiredItems();
+    const size_t active_group = active_group_.load(std::memory_order_relaxed);
+    const bool switched = (active_group != published_group_);
+    published_group_ = active_group;
+    if (drained || expired || switched) {
+      PublishRanking();
+    }
+    ScheduleExpiry(esp_timer_get_time() / 1000);
+  }
+
+  const uint32_t dropped_count = scan_ring_.GetDroppedCount();
+  if (dropped_count != reported_dropped_count_) {
+    ESP_LOGW(kTag,
+             "Scan ring overflow. overflow:%" PRIu32 " dropped:%" PRIu32,
+             scan_ring_.GetOverflowCount(), dropped_count);
+    reported_dropped_count_ = dropped_count;
+  }
 
-std::vector<BleBeaconItem> BeaconReceiveTask::GetRSSISortedItems() {
   const int64_t now_ms = esp_timer_get_time() / 1000;
-  std::vector<BleBeaconItem> ble_beacon_list;
-  {
-    std::scoped_lock lock(beacon_items_mutex_);
-    // Remove entries not seen within the expiry window
-    for (auto it = ble_beacon_items_.begin(); it != ble_beacon_items_.end();) {
-      if ((now_ms - it->last_seen_ms) > kBeaconExpiryMs) {
-        it = ble_beacon_items_.erase(it);
-      } else {
-        ++it;
-      }
+  if ((now_ms - last_stats_log_ms_) >= kScanStatsLogIntervalMs) {
+    const uint32_t duty = scan_scheduler_.GetDutyPerMille(now_ms);
+    ESP_LOGI(kTag,
+             "Scan host events:%" PRIu32 "/s avoided:%" PRIu32
+             "/s beacons:%zu radio_on:%" PRId64 "ms duty:%" PRIu32 ".%" PRIu32
+             "%%",
+             GetHostEventRate(), GetAvoidedHostEventRate(),
+             GetBeaconTableOccupancy(), scan_scheduler_.GetRadioOnMs(),
+             duty / 10, duty % 10);
+    if (power_manager_ != nullptr) {
+      power_manager_->LogCurrentEstimate(scan_scheduler_.GetRadioOnMs());
+    }
+    last_stats_log_ms_ = now_ms;
+  }
+  if ((now_ms - last_stack_log_ms_) >= kStackLogIntervalMs) {
+    // High-water marks of all tasks, to tune the kStackDepth values
+    Task::LogStackUsage();
+    last_stack_log_ms_ = now_ms;
+  }
+}
+
+void BeaconReceiveTask::GetRankedItems(RankedItems* const ranked_items) {
+  std::scoped_lock lock(ranked_items_mutex_);
+  *ranked_items = ranked_items_;
+}
+
+void BeaconReceiveTask::RestoreActiveItem(const BleBeaconItem& item) {
+  std::scoped_lock lock(tracker_mutex_);
+  published_group_ = active_group_.load(std::memory_order_relaxed);
+  if (tracker_.Restore(published_group_, item,
+                       esp_timer_get_time() / 1000)) {
+    PublishRanking();
+  }
+  UpdateGroupOccupancy();
+}
+
+void BeaconReceiveTask::SetViewChangeNotifyTask(const TaskHandle_t task) {
+  view_change_notify_task_.store(task, std::memory_order_relaxed);
+}
+
+void BeaconReceiveTask::SetPowerManager(PowerManager* const power_manager) {
+  power_manager_ = power_manager;
+}
+
+void BeaconReceiveTask::SetScanTraceRecorder(
+    ScanTraceRecorder* const scan_trace_recorder) {
+  scan_trace_recorder_ = scan_trace_recorder;
+}
+
+uint32_t BeaconReceiveTask::GetScanOverflowCount() const {
+  return scan_ring_.GetOverflowCount();
+}
+
+uint32_t BeaconReceiveTask::GetScanDroppedCount() const {
+  return scan_ring_.GetDroppedCount();
+}
+
+size_t BeaconReceiveTask::GetBeaconTableOccupancy() const {
+  size_t occupancy = 0;
+  for (size_t group = 0; group < tracker_.GetGroupNum(); ++group) {
+    occupancy += group_occupancy_[group].load(std::memory_order_relaxed);
+  }
+  return occupancy;
+}
+
+size_t BeaconReceiveTask::GetGroupOccupancy(const size_t group) const {
+  if (group >= tracker_.GetGroupNum()) {
+    return 0;
+  }
+  return group_occupancy_[group].load(std::memory_order_relaxed);
+}
+
+void BeaconReceiveTask::SetActiveGroup(const size_t group) {
+  if (group >= tracker_.GetGroupNum()) {
+    ESP_LOGW(kTag, "Invalid beacon group: %zu", group);
+    return;
+  }
+  active_group_.store(group, std::memory_order_relaxed);
+  RequestUpdate(0);
+}
+
+size_t BeaconReceiveTask::GetActiveGroup() const {
+  return active_group_.load(std::memory_order_relaxed);
+}
+
+uint32_t BeaconReceiveTask::GetHostEventRate() const {
+  return scan_filter_.GetHostEventRate();
+}
+
+uint32_t BeaconReceiveTask::GetAvoidedHostEventRate() const {
+  return scan_filter_.GetAvoidedEventRate();
+}
+
+void BeaconReceiveTask::RequestFastScan() {
+  scan_scheduler_.OnUserActivity(esp_timer_get_time() / 1000);
+}
+
+void BeaconReceiveTask::SetScanPolicy(const ScanScheduler::Policy policy) {
+  scan_scheduler_.SetPolicy(policy);
+}
+
+bool BeaconReceiveTask::DrainScanRing() {
+  if (scan_ring_.Size() == 0) {
+    return false;
+  }
+
+  const int64_t now_ms = esp_timer_get_time() / 1000;
+  bool ranking_changed = false;
+  ScanRecord record;
+  while (scan_ring_.Pop(&record)) {
+    if (scan_trace_recorder_ != nullptr) {
+      scan_trace_recorder_->Append(record);
+    }
+    if (tracker_.Update(record, now_ms, rssi_filter_mode_,
+                        distance_estimator::kDefaultPathLossExponentX10) &&
+        record.group == published_group_) {
+      ranking_changed = true;
     }
-    ble_beacon_list.reserve(ble_beacon_items_.size());
-    ble_beacon_list.assign(ble_beacon_items_.begin(), ble_beacon_items_.end());
   }
-  std::sort(ble_beacon_list.begin(), ble_beacon_list.end(),
-            [](const BleBeaconItem& a, const BleBeaconItem& b) {
-              return a.rssi > b.rssi;
-            });
-  return ble_beacon_list;
+  UpdateGroupOccupancy();
+  return ranking_changed;
+}
+
+bool BeaconReceiveTask::RemoveExpiredItems() {
+  const uint32_t changed_groups =
+      tracker_.RemoveExpired(esp_timer_get_time() / 1000);
+  if (changed_groups == 0) {
+    return false;
+  }
+  UpdateGroupOccupancy();
+  return (changed_groups & (1u << published_group_)) != 0;
+}
+
+void BeaconReceiveTask::ScheduleExpiry(const int64_t now_ms) {
+  const int64_t expiry_ms = tracker_.GetNextExpiryMs();
+  if (expiry_ms == INT64_MAX) {
+    return;  // nothing tracked, no wakeup
+  }
+  // Removed once past the expiry time
+  const uint32_t delay_ms =
+      static_cast<uint32_t>(std::max<int64_t>(expiry_ms + 1 - now_ms, 0));
+  RequestUpdate(delay_ms);
+  // A record pushed during this update armed its drain, which is sooner
+  if (drain_requested_.load(std::memory_order_relaxed)) {
+    RequestUpdate(std::min(delay_ms, kDrainIntervalMs));
+  }
+}
+
+void BeaconReceiveTask::UpdateGroupOccupancy() {
+  for (size_t group = 0; group < tracker_.GetGroupNum(); ++group) {
+    group_occupancy_[group].store(tracker_.GetGroupSize(group),
+                                  std::memory_order_relaxed);
+  }
+}
+
+void BeaconReceiveTask::PublishRanking() {
+  RankedItems ranked_items;
+  tracker_.GetRankedItems(published_group_, &ranked_items);
+
+  bool view_changed = false;
+  {
+    std::scoped_lock lock(ranked_items_mutex_);
+    view_changed = BeaconTracker::IsViewChanged(ranked_items_, ranked_items);
+    ranked_items_ = ranked_items;
+  }
+
+  const TaskHandle_t notify_task =
+      view_change_notify_task_.load(std::memory_order_relaxed);
+  if (view_changed && notify_task != nullptr) {
+    xTaskNotifyGive(notify_task);
+  }
 }
 
 void BeaconReceiveTask::HostTaskStatic(void* param) {
@@ -97,25 +323,37 @@ void BeaconReceiveTask::OnSyncStatic() {
 void BeaconReceiveTask::OnSync() {
   ESP_LOGI(kTag, "NimBLE host synced, starting scan");
 
-  struct ble_gap_disc_params disc_params;
-  std::memset(&disc_params, 0, sizeof(disc_params));
-  disc_params.filter_duplicates = 0; // Receive all updates for accurate RSSI and expiry
-  disc_params.passive = 1;
-  disc_params.itvl = 0x00A0; // 160 * 0.625ms = 100ms
-  disc_params.window = 0x00A0; // 160 * 0.625ms = 100ms (continuous scan)
-
-  uint8_t own_addr_type;
-  int rc = ble_hs_id_infer_auto(0, &own_addr_type);
+  int rc = ble_hs_id_infer_auto(0, &own_addr_type_);
   if (rc != 0) {
     ESP_LOGE(kTag, "ble_hs_id_infer_auto failed: %d", rc);
     return;
   }
 
-  rc = ble_gap_disc(own_addr_type, BLE_HS_FOREVER, &disc_params, GapEventStatic, nullptr);
+  StartScan();
+}
+
+void BeaconReceiveTask::StartScan() {
+  const int64_t now_ms = esp_timer_get_time() / 1000;
+  const ScanFilter::Phase phase = scan_filter_.BeginPhase(now_ms);
+  const ScanScheduler::ScanParams scan_params =
+      scan_scheduler_.BeginPhase(now_ms, phase.duration_ms);
+
+  struct ble_gap_disc_params disc_params;
+  std::memset(&disc_params, 0, sizeof(disc_params));
+  // The controller drops repeats until the phase ends and the scan restarts,
+  // which resets its duplicate cache and lets fresh RSSI through.
+  disc_params.filter_duplicates = 1;
+  disc_params.passive = 1;
+  disc_params.itvl = scan_params.itvl;
+  disc_params.window = scan_params.window;
+  disc_params.filter_policy = phase.use_accept_list ? BLE_HCI_SCAN_FILT_USE_WL
+                                                    : BLE_HCI_SCAN_FILT_NO_WL;
+
+  const int rc =
+      ble_gap_disc(own_addr_type_, scan_params.duration_ms, &disc_params,
+                   GapEventStatic, nullptr);
   if (rc != 0) {
     ESP_LOGE(kTag, "Scanning start failed, error %d", rc);
-  } else {
-    ESP_LOGI(kTag, "Scanning start successfully");
   }
 }
 
@@ -127,47 +365,48 @@ int BeaconReceiveTask::GapEventStatic(struct ble_gap_event* event, void* arg) {
 }
 
 int BeaconReceiveTask::GapEvent(struct ble_gap_event* event, void* arg) {
-  if (event->type == BLE_GAP_EVENT_DISC) {
-    if (IsIBeaconPacket(event->disc.data, event->disc.length_data)) {
-      const BleIBeacon* ibeacon_data =
-          reinterpret_cast<const BleIBeacon*>(event->disc.data);
-      const uint16_t major = EndianChangeU16(ibeacon_data->ibeacon_vendor.major);
-      const uint16_t minor = EndianChangeU16(ibeacon_data->ibeacon_vendor.minor);
-
-      if (std::memcmp(ibeacon_data->ibeacon_vendor.proximity_uuid,
-                      target_proximity_uuid_,
-                      sizeof(target_proximity_uuid_)) != 0 ||
-          major != target_major_id_) {
-        return 0;
-      }
-
-      BleBeaconItem item = {.minor = minor,
-                            .rssi = event->disc.rssi,
-                            .last_seen_ms = esp_timer_get_time() / 1000};
-
-      {
-        std::scoped_lock lock(beacon_items_mutex_);
-
-        auto [it, inserted] = ble_beacon_items_.insert(item);
-        if (!inserted) {
-          ble_beacon_items_.erase(it);
-          ble_beacon_items_.insert(item);
-        }
-      }
+  if (event->type == BLE_GAP_EVENT_DISC_COMPLETE) {
+    // Scan phase finished, restart with refreshed filter and duty cycle
+    const int64_t now_ms = esp_timer_get_time() / 1000;
+    scan_filter_.EndPhase(now_ms);
+    scan_scheduler_.EndPhase(now_ms);
+    StartScan();
+    scan_restart_counter.Increment();
+  } else if (event->type == BLE_GAP_EVENT_DISC) {
+    perf::ScopedTimer gap_event_timer(&gap_event_histogram);
+    adv_received_counter.Increment();
+    scan_filter_.OnHostEvent();
+    // Frame formats carrying (uuid, major, minor) are accepted as targets
+    BeaconFrame frame;
+    const int group =
+        tracker_.Match(event->disc.data, event->disc.length_data, &frame);
+    if (group < 0) {
+      adv_rejected_counter.Increment();
+      return 0;
     }
-  }
-  return 0;
-}
+    adv_accepted_counter.Increment();
 
-bool BeaconReceiveTask::IsIBeaconPacket(const uint8_t* adv_data,
-                                        const uint8_t adv_data_len) const {
-  if (adv_data != nullptr && adv_data_len == 0x1e) {
-    if (!std::memcmp(adv_data, reinterpret_cast<const uint8_t*>(&kIBeaconHeader),
-                     sizeof(kIBeaconHeader))) {
-      return true;
+    const int64_t now_ms = esp_timer_get_time() / 1000;
+    ScanFilter::Address address = {.type = event->disc.addr.type};
+    std::memcpy(address.value, event->disc.addr.val, sizeof(address.value));
+    scan_filter_.OnTargetSeen(address, now_ms);
+    scan_scheduler_.OnTargetSeen(now_ms);
+
+    // Lock-free hand-off to BeaconReceiveTask (drops when full)
+    const ScanRecord record = {.timestamp_ms = static_cast<uint32_t>(now_ms),
+                               .minor = frame.minor,
+                               .rssi = event->disc.rssi,
+                               .measured_power = frame.measured_power,
+                               .group = static_cast<uint8_t>(group)};
+    scan_ring_.Push(record);
+    // The first record batches the following ones for kDrainIntervalMs;
+    // no wakeup while nothing is heard, so the CPU can light-sleep
+    if (!drain_requested_.exchange(true, std::memory_order_relaxed) &&
+        !RequestUpdate(kDrainIntervalMs)) {
+      drain_requested_.store(false, std::memory_order_relaxed);
     }
   }
-  return false;
+  return 0;
 }
 
 }  // namespace bfox_receiver_system
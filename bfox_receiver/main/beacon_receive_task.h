@@ -6,57 +6,155 @@
 // Include ----------------------
 #include <soc/soc.h>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
-#include <set>
-#include <vector>
 
-#include "ble_beacon_item.h"
+#include "beacon_group.h"
+#include "beacon_tracker.h"
+#include "power_manager.h"
+#include "rssi_filter.h"
+#include "scan_filter.h"
+#include "scan_record.h"
+#include "scan_scheduler.h"
+#include "scan_trace_recorder.h"
+#include "spsc_ring.h"
 #include "task.h"
 
 struct ble_gap_event;
 
 namespace bfox_receiver_system {
 
+/// Runs on an EventLoop (StartOn with no interval); the NimBLE host keeps
+/// its own task. Updates are one-shot: a received record, an entry expiry
+/// or a group switch. Nothing wakes the CPU while no beacon is tracked.
 class BeaconReceiveTask final : public Task {
  public:
   static constexpr const char* kTaskName = "BeaconReceiveTask";
   static constexpr int kPriority = Task::kPriorityLow;
   static constexpr int kCoreId = tskNO_AFFINITY;
-  static constexpr int64_t kBeaconExpiryMs = 3000;  // entries unseen for 3s are removed
+  static constexpr uint32_t kDrainIntervalMs = 100;  // scan ring batch period
+  static constexpr size_t kScanRingCapacity = 128;
+  static constexpr int64_t kScanStatsLogIntervalMs = 10000;
+  static constexpr int64_t kStackLogIntervalMs = 60000;
+  static constexpr size_t kMaxGroupNum = BeaconTracker::kMaxGroupNum;
+  static constexpr size_t kRankedItemNum = BeaconTracker::kRankedItemNum;
+  static constexpr RssiFilterMode kDefaultRssiFilterMode =
+      RssiFilterMode::kEma;
+
+  using ScanRing = SpscRing<ScanRecord, kScanRingCapacity>;
+  using RankedItems = BeaconTracker::RankedItems;
 
  private:
   static BeaconReceiveTask* instance_;
 
  public:
-  BeaconReceiveTask(const uint8_t target_proximity_uuid[16],
-                    const uint16_t target_major_id);
+  /// Track all groups (up to kMaxGroupNum) at once; the ranking of
+  /// active_group is published to the UI. The RSSI filter is fixed for the
+  /// task's life.
+  BeaconReceiveTask(
+      const BeaconGroup* const groups, const size_t group_num,
+      const size_t active_group,
+      const RssiFilterMode rssi_filter_mode = kDefaultRssiFilterMode);
 
   void Initialize() override;
 
+  /// Drain, expire and publish. Called kDrainIntervalMs after a record
+  /// arrives and when the oldest entry expires.
   void Update() override;
 
-  std::vector<BleBeaconItem> GetRSSISortedItems();
+  /// Copy the strongest beacons (RSSI descending) without allocation
+  void GetRankedItems(RankedItems* const ranked_items);
+
+  /// Visit the beacons of the active group (blocks the receive task)
+  template <typename Function>
+  void ForEachActiveItem(Function function) {
+    std::scoped_lock lock(tracker_mutex_);
+    tracker_.ForEachItem(active_group_.load(std::memory_order_relaxed),
+                         function);
+  }
+
+  /// Put a beacon saved before deep sleep back into the active group and
+  /// publish the ranking
+  void RestoreActiveItem(const BleBeaconItem& item);
+
+  /// Task notified (xTaskNotifyGive) when the displayed ranking changes:
+  /// order, RSSI indicator level or distance at display resolution
+  void SetViewChangeNotifyTask(const TaskHandle_t task);
+
+  /// Record every accepted scan event (set before Start)
+  void SetScanTraceRecorder(ScanTraceRecorder* const scan_trace_recorder);
+
+  /// Log the current estimate with the scan statistics (set before Start)
+  void SetPowerManager(PowerManager* const power_manager);
+
+  uint32_t GetScanOverflowCount() const;
+  uint32_t GetScanDroppedCount() const;
+
+  /// Beacons tracked in all groups / in one group
+  size_t GetBeaconTableOccupancy() const;
+  size_t GetGroupOccupancy(const size_t group) const;
+
+  /// Switch the published ranking to another group (scan keeps running),
+  /// published by an immediate update
+  void SetActiveGroup(const size_t group);
+  size_t GetActiveGroup() const;
+  size_t GetGroupNum() const { return tracker_.GetGroupNum(); }
+
+  /// Advertisement events delivered to / avoided on the host [events/s]
+  uint32_t GetHostEventRate() const;
+  uint32_t GetAvoidedHostEventRate() const;
+
+  /// Return to continuous scanning (user activity)
+  void RequestFastScan();
+
+  void SetScanPolicy(const ScanScheduler::Policy policy);
 
  private:
+  bool DrainScanRing();
+  bool RemoveExpiredItems();
+  void ScheduleExpiry(const int64_t now_ms);
+  void UpdateGroupOccupancy();
+  void PublishRanking();
+
   static void HostTaskStatic(void* param);
   void HostTask();
 
   static void OnSyncStatic();
   void OnSync();
 
+  void StartScan();
+
   static int GapEventStatic(struct ble_gap_event* event, void* arg);
   int GapEvent(struct ble_gap_event* event, void* arg);
 
-  bool IsIBeaconPacket(const uint8_t* adv_data,
-                       const uint8_t adv_data_len) const;
-
  private:
-  std::mutex beacon_items_mutex_;
-  std::set<BleBeaconItem> ble_beacon_items_;
-
-  uint8_t target_proximity_uuid_[16];
-  uint16_t target_major_id_;
+  ScanRing scan_ring_;  // NimBLE host task -> BeaconReceiveTask
+  std::atomic<bool> drain_requested_;  // Update scheduled for pushed records
+  uint32_t reported_dropped_count_;
+  int64_t last_stats_log_ms_;
+  int64_t last_stack_log_ms_;
+
+  // NimBLE host task
+  ScanFilter scan_filter_;
+  ScanScheduler scan_scheduler_;
+  uint8_t own_addr_type_;
+
+  // Matching is read-only from the NimBLE host task, updates are owned by
+  // BeaconReceiveTask. tracker_mutex_ guards the tables against other tasks.
+  std::mutex tracker_mutex_;
+  BeaconTracker tracker_;
+  size_t published_group_;
+  std::atomic<size_t> active_group_;
+  std::atomic<size_t> group_occupancy_[kMaxGroupNum];
+  ScanTraceRecorder* scan_trace_recorder_;
+  PowerManager* power_manager_;
+  RssiFilterMode rssi_filter_mode_;  // chosen at build time
+
+  // Published to the UI
+  std::mutex ranked_items_mutex_;
+  RankedItems ranked_items_;
+  std::atomic<TaskHandle_t> view_change_notify_task_;
 };
 
 using BeaconReceiveTaskUniquePtr = std::unique_ptr<BeaconReceiveTask>;
@@ -0,0 +1,148 @@
+#ifndef BFOX_RECEIVER_MAIN_BEACON_TABLE_H_
+#define BFOX_RECEIVER_MAIN_BEACON_TABLE_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+#include "ble_beacon_item.h"
+
+namespace bfox_receiver_system {
+
+/// Statically sized open-addressed (linear probing) table of beacons keyed by
+/// minor. Entries are updated in place and never allocate.
+template <size_t kCapacity>
+class BeaconTable {
+ public:
+  static_assert(kCapacity >= 4 && (kCapacity & (kCapacity - 1)) == 0,
+                "kCapacity must be a power of two");
+
+  /// Maximum number of beacons (load factor 3/4 keeps probe chains short)
+  static constexpr size_t kMaxItems = kCapacity * 3 / 4;
+
+ private:
+  static constexpr uint32_t kIndexMask = kCapacity - 1;
+
+  struct Slot {
+    bool used;
+    BleBeaconItem item;
+  };
+
+ public:
+  BeaconTable() : slots_(), size_(0), rejected_count_(0) {}
+
+  /// Find beacon, nullptr if not exist
+  BleBeaconItem* Find(const uint16_t minor) {
+    for (uint32_t i = Hash(minor), probe = 0; probe < kCapacity;
+         i = (i + 1) & kIndexMask, ++probe) {
+      if (!slots_[i].used) {
+        return nullptr;
+      }
+      if (slots_[i].item.minor == minor) {
+        return &slots_[i].item;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Find beacon or insert a new zeroed entry. nullptr if table is full.
+  BleBeaconItem* FindOrInsert(const uint16_t minor, bool* const inserted) {
+    *inserted = false;
+    uint32_t i = Hash(minor);
+    for (uint32_t probe = 0; probe < kCapacity;
+         i = (i + 1) & kIndexMask, ++probe) {
+      if (!slots_[i].used) {
+        break;
+      }
+      if (slots_[i].item.minor == minor) {
+        return &slots_[i].item;
+      }
+    }
+    if (size_ >= kMaxItems) {
+      ++rejected_count_;
+      return nullptr;
+    }
+    slots_[i].used = true;
+    slots_[i].item = {};
+    slots_[i].item.minor = minor;
+    ++size_;
+    *inserted = true;
+    return &slots_[i].item;
+  }
+
+  /// Remove all entries matching predicate. Returns removed count.
+  template <typename Predicate>
+  size_t EraseIf(Predicate predicate) {
+    size_t erased = 0;
+    for (uint32_t i = 0; i < kCapacity;) {
+      if (slots_[i].used && predicate(slots_[i].item)) {
+        EraseSlot(i);  // a following entry may shift into slot i
+        ++erased;
+      } else {
+        ++i;
+      }
+    }
+    return erased;
+  }
+
+  template <typename Function>
+  void ForEach(Function function) const {
+    for (const Slot& slot : slots_) {
+      if (slot.used) {
+        function(slot.item);
+      }
+    }
+  }
+
+  void Clear() {
+    for (Slot& slot : slots_) {
+      slot.used = false;
+    }
+    size_ = 0;
+  }
+
+  size_t Size() const { return size_; }
+
+  static constexpr size_t Capacity() { return kMaxItems; }
+
+  /// Static memory used by the table [byte]
+  static constexpr size_t MemoryFootprint() { return sizeof(BeaconTable); }
+
+  /// Number of beacons not stored because the table was full
+  uint32_t GetRejectedCount() const { return rejected_count_; }
+
+ private:
+  static constexpr uint32_t Hash(const uint16_t minor) {
+    // Fibonacci hashing spreads sequential minor numbers over the table
+    return ((minor * 40503u) & 0xFFFFu) * kCapacity >> 16;
+  }
+
+  /// Backward shift deletion (no tombstones)
+  void EraseSlot(uint32_t hole) {
+    slots_[hole].used = false;
+    --size_;
+    for (uint32_t i = (hole + 1) & kIndexMask; slots_[i].used;
+         i = (i + 1) & kIndexMask) {
+      const uint32_t home = Hash(slots_[i].item.minor);
+      // Move entry i into the hole unless its home lies in (hole, i]
+      const bool home_in_range =
+          (hole <= i) ? (hole < home && home <= i) : (hole < home || home <= i);
+      if (!home_in_range) {
+        slots_[hole] = slots_[i];
+        slots_[i].used = false;
+        hole = i;
+      }
+    }
+  }
+
+ private:
+  Slot slots_[kCapacity];
+  size_t size_;
+  uint32_t rejected_count_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_BEACON_TABLE_H_
@@ -0,0 +1,144 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "beacon_tracker.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "distance_estimator.h"
+#include "rssi_indicator.h"
+
+namespace bfox_receiver_system {
+
+BeaconTracker::BeaconTracker(const BeaconGroup* const groups,
+                             const size_t group_num)
+    : groups_(), group_num_(std::min(group_num, kMaxGroupNum)), group_items_() {
+  std::copy(groups, groups + group_num_, groups_);
+}
+
+int BeaconTracker::Match(const uint8_t* const adv_data,
+                         const uint8_t adv_data_len,
+                         BeaconFrame* const frame) const {
+  // Frame formats carrying (uuid, major, minor) are accepted as targets
+  if (!ParseBeaconFrame<ad_decoder::IBeacon, ad_decoder::AltBeacon>(
+          adv_data, adv_data_len, frame)) {
+    return -1;
+  }
+  for (size_t group = 0; group < group_num_; ++group) {
+    // Compare the cheap major first, most frames differ there
+    if (groups_[group].major == frame->major &&
+        std::memcmp(groups_[group].proximity_uuid, frame->uuid,
+                    sizeof(frame->uuid)) == 0) {
+      return static_cast<int>(group);
+    }
+  }
+  return -1;
+}
+
+bool BeaconTracker::Update(const ScanRecord& record, const int64_t now_ms,
+                           const RssiFilterMode rssi_filter_mode,
+                           const int32_t path_loss_exponent_x10) {
+  if (record.group >= group_num_) {
+    return false;
+  }
+  GroupItems& group_items = group_items_[record.group];
+  bool inserted = false;
+  BleBeaconItem* const item =
+      group_items.table.FindOrInsert(record.minor, &inserted);
+  if (item == nullptr) {
+    return false;  // table full
+  }
+  item->rssi = item->rssi_filter.Apply(rssi_filter_mode, record.rssi);
+  item->measured_power = record.measured_power;
+  item->distance_cm = distance_estimator::EstimateDistanceCm(
+      item->measured_power, item->rssi, path_loss_exponent_x10);
+  // Records carry a truncated timestamp; restore it relative to now
+  item->last_seen_ms =
+      now_ms - (static_cast<uint32_t>(now_ms) - record.timestamp_ms);
+  // The regression smooths on its own, unfiltered RSSI keeps it responsive
+  item->trend = item->rssi_trend.Add(item->last_seen_ms, record.rssi);
+
+  return group_items.ranking.OnUpdate(*item, group_items.table);
+}
+
+bool BeaconTracker::Restore(const size_t group, const BleBeaconItem& item,
+                            const int64_t now_ms) {
+  if (group >= group_num_) {
+    return false;
+  }
+  GroupItems& group_items = group_items_[group];
+  bool inserted = false;
+  BleBeaconItem* const restored =
+      group_items.table.FindOrInsert(item.minor, &inserted);
+  if (restored == nullptr) {
+    return false;  // table full
+  }
+  *restored = item;
+  restored->last_seen_ms = now_ms;
+  restored->rssi_trend = RssiTrend();
+  restored->trend = RssiTrend::Direction::kUnknown;
+
+  return group_items.ranking.OnUpdate(*restored, group_items.table);
+}
+
+uint32_t BeaconTracker::RemoveExpired(const int64_t now_ms) {
+  uint32_t changed_groups = 0;
+  for (size_t group = 0; group < group_num_; ++group) {
+    GroupItems& group_items = group_items_[group];
+    // Remove entries not seen within the expiry window
+    const size_t erased =
+        group_items.table.EraseIf([now_ms](const BleBeaconItem& item) {
+          return (now_ms - item.last_seen_ms) > kBeaconExpiryMs;
+        });
+    if (erased != 0) {
+      group_items.ranking.Rebuild(group_items.table);
+      changed_groups |= 1u << group;
+    }
+  }
+  return changed_groups;
+}
+
+int64_t BeaconTracker::GetNextExpiryMs() const {
+  int64_t expiry_ms = INT64_MAX;
+  for (size_t group = 0; group < group_num_; ++group) {
+    group_items_[group].table.ForEach([&expiry_ms](const BleBeaconItem& item) {
+      expiry_ms = std::min(expiry_ms, item.last_seen_ms + kBeaconExpiryMs);
+    });
+  }
+  return expiry_ms;
+}
+
+void BeaconTracker::GetRankedItems(const size_t group,
+                                   RankedItems* const ranked_items) const {
+  if (group >= group_num_) {
+    ranked_items->count = 0;
+    return;
+  }
+  group_items_[group].ranking.GetSnapshot(ranked_items);
+}
+
+size_t BeaconTracker::GetGroupSize(const size_t group) const {
+  return (group < group_num_) ? group_items_[group].table.Size() : 0;
+}
+
+bool BeaconTracker::IsViewChanged(const RankedItems& before,
+                                  const RankedItems& after) {
+  if (before.count != after.count) {
+    return true;
+  }
+  for (size_t i = 0; i < after.count; ++i) {
+    const BleBeaconItem& a = before.items[i];
+    const BleBeaconItem& b = after.items[i];
+    if (a.minor != b.minor ||
+        rssi_indicator::GetLevel(a.rssi) != rssi_indicator::GetLevel(b.rssi) ||
+        a.distance_cm / 10 != b.distance_cm / 10 ||  // 0.1m
+        a.trend != b.trend) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,98 @@
+#ifndef BFOX_RECEIVER_MAIN_BEACON_TRACKER_H_
+#define BFOX_RECEIVER_MAIN_BEACON_TRACKER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+#include "ad_parser.h"
+#include "beacon_group.h"
+#include "beacon_ranking.h"
+#include "beacon_table.h"
+#include "ble_beacon_item.h"
+#include "rssi_filter.h"
+#include "scan_record.h"
+
+namespace bfox_receiver_system {
+
+/// Advertisement matching and per-group beacon tables / rankings.
+///
+/// Holds no ESP-IDF or NimBLE state; time and settings are passed in, so
+/// the receive path builds and runs the same way off target.
+class BeaconTracker final {
+ public:
+  static constexpr int64_t kBeaconExpiryMs = 3000;  // entries unseen for 3s are removed
+  static constexpr size_t kBeaconTableCapacity = 32;  // slots (24 beacons)
+  static constexpr size_t kMaxGroupNum = 10;  // tracked (UUID, major) groups
+  static constexpr size_t kRankedItemNum = 2;  // LCD display lines
+
+  using BeaconItemTable = BeaconTable<kBeaconTableCapacity>;
+  using BeaconItemRanking = BeaconRanking<kRankedItemNum>;
+  using RankedItems = BeaconItemRanking::Snapshot;
+
+ public:
+  /// Groups beyond kMaxGroupNum are ignored
+  BeaconTracker(const BeaconGroup* const groups, const size_t group_num);
+
+  size_t GetGroupNum() const { return group_num_; }
+
+  /// Parse an advertisement and match it against the group table.
+  /// Returns the group index, or -1. Read-only, safe from the NimBLE host
+  /// task while another task updates the tables.
+  int Match(const uint8_t* const adv_data, const uint8_t adv_data_len,
+            BeaconFrame* const frame) const;
+
+  /// Apply a scan record. Returns true if its group's ranking changed.
+  bool Update(const ScanRecord& record, const int64_t now_ms,
+              const RssiFilterMode rssi_filter_mode,
+              const int32_t path_loss_exponent_x10);
+
+  /// Remove expired entries. Returns a bit mask of groups whose ranking
+  /// changed.
+  uint32_t RemoveExpired(const int64_t now_ms);
+
+  /// Time [ms] the oldest entry of any group expires at (removed by
+  /// RemoveExpired after it), INT64_MAX while every table is empty
+  int64_t GetNextExpiryMs() const;
+
+  /// Put a saved entry back, seen at now_ms (warm resume). The trend
+  /// restarts. Returns true if the group's ranking changed.
+  bool Restore(const size_t group, const BleBeaconItem& item,
+               const int64_t now_ms);
+
+  template <typename Function>
+  void ForEachItem(const size_t group, Function function) const {
+    if (group < group_num_) {
+      group_items_[group].table.ForEach(function);
+    }
+  }
+
+  void GetRankedItems(const size_t group,
+                      RankedItems* const ranked_items) const;
+  size_t GetGroupSize(const size_t group) const;
+
+  /// True if the ranking looks different on the LCD: order, RSSI indicator
+  /// level, distance at display resolution or trend arrow
+  static bool IsViewChanged(const RankedItems& before,
+                            const RankedItems& after);
+
+ private:
+  struct GroupItems {
+    BeaconItemTable table;
+    BeaconItemRanking ranking;
+  };
+
+  static_assert(kMaxGroupNum <= 32, "RemoveExpired returns a 32bit mask");
+
+  // Compiled filter table, matched once per advertisement
+  BeaconGroup groups_[kMaxGroupNum];
+  size_t group_num_;
+
+  GroupItems group_items_[kMaxGroupNum];
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_BEACON_TRACKER_H_
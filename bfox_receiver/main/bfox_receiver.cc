@@ -7,16 +7,21 @@
 #include "bfox_receiver.h"
 #include "driver/gpio.h"
 #include "driver/rtc_io.h"
-#include "esp_adc/adc_cali.h"
-#include "esp_adc/adc_cali_scheme.h"
+#include "esp_attr.h"
 #include "esp_sleep.h"
 #include "esp_system.h"
 #include "esp_timer.h"
 #include "gpio_control.h"
 #include "i2c_util.h"
+#include "init_sequencer.h"
 #include "logger.h"
 #include "nvs_flash.h"
+#include "sdkconfig.h"
+#include "perf_counters.h"
 #include "receiver_setting.h"
+#include "resume_state.h"
+#include "rssi_indicator.h"
+#include "search_view.h"
 #include "st7032.h"
 #include "util.h"
 #include "version.h"
@@ -44,9 +49,17 @@ const gpio_num_t kUnusedGpioPins[] = {
 };
 
 constexpr float kBatteryDischargeLimit = 3.2f;
-constexpr int kIndicatorRssiNum = 6;
-const int kIndicatorRssiTargets[kIndicatorRssiNum] = {INT_MIN, -100, -80,
-                                                      -70,     -60,  -50};
+constexpr uint32_t kBatteryDividerRatio = 2;  // A0 sees half the battery
+constexpr uint32_t kBatteryReadyTimeoutMs = 500;
+// The battery is sampled for kBatterySampleMs (a few DMA frames into the
+// monitor's IIR) every kBatteryRefreshIntervalMs, the ADC is stopped between
+constexpr uint32_t kBatteryRefreshIntervalMs = 60000;
+constexpr uint32_t kBatterySampleMs = 500;
+
+// 0V: monitor not ready, not an empty battery
+static bool IsBatteryDischarged(const float voltage) {
+  return 0.0f < voltage && voltage <= kBatteryDischargeLimit;
+}
 
 static const uint8_t kTargetProximityUuid[16] = {
     0xC6, 0x5B, 0x2C, 0x5D,             // C65B2C5D
@@ -56,17 +69,62 @@ static const uint8_t kTargetProximityUuid[16] = {
     0x54, 0xD9, 0xE2, 0xF2, 0x11, 0x88  // 54D9E2F21188
 };
 
+// One beacon group per course (major 0-9), all tracked at once
+constexpr size_t kCourseNum = 10;
+static_assert(kCourseNum <= BeaconReceiveTask::kMaxGroupNum,
+              "Receive task must track all courses");
+
+// Advertising interval the course beacons are set to (bfox_beacon setting,
+// written over GATT). Sizes the idle scan window: a slower beacon may be
+// missed by an idle window, a faster one is always covered.
+constexpr uint16_t kCourseBeaconAdvIntervalMs = 500;
+
+// RSSI smoothing of the search screen, a build time choice (compare the
+// modes with rssi_filter_replay_test)
+constexpr RssiFilterMode kRssiFilterMode =
+    BeaconReceiveTask::kDefaultRssiFilterMode;
+
+// Record scan events to the storage partition (development)
+constexpr bool kScanTraceEnabled = false;
+
+// ISR to task latency of the MessageQueue backends into the perf histograms
+// (development, keeps a GPTimer running for a few seconds)
+constexpr bool kMessageQueueBenchEnabled = false;
+
 constexpr int64_t kSleepTimeoutMs = 30000;  // Enter Deep Sleep after 30s of inactivity
 constexpr i2c_port_t kI2cPortNo = I2C_NUM_0;
-constexpr int kLcdDisplayLines = 2;
+static_assert(ST7032::kTxSlotNum <= i2c_util::kTransQueueDepth,
+              "I2C bus queue must hold every LCD transfer in flight");
+constexpr int kLcdDisplayLines = search_view::kLcdLines;
+constexpr int64_t kMinFrameIntervalMs = 100;  // LCD redraw rate limit
+constexpr uint32_t kInitialWaitMs = 2000;  // longest initial screen
+static_assert(kLcdDisplayLines <= BeaconReceiveTask::kRankedItemNum,
+              "Ranking must cover all LCD lines");
+
+// Search state kept over deep sleep (garbage after power on, see magic)
+RTC_DATA_ATTR static ResumeState resume_state;
+
+static perf::Histogram lcd_frame_histogram("lcd.frame_us");
 
 BFoxReceiver::BFoxReceiver()
-    : gpio_watcher_(),
+    : ui_task_(nullptr),
+      event_loop_task_(),
+      gpio_watcher_(),
       st7032_(),
+      glyph_manager_(st7032_),
+      battery_monitor_(ADC_CHANNEL_0, kBatteryDividerRatio),
+      battery_start_timer_(&BFoxReceiver::OnBatterySampleStart, this),
+      battery_done_timer_(&BFoxReceiver::OnBatterySampleDone, this),
+      power_manager_(),
+      scan_trace_recorder_(),
+      message_queue_bench_(),
       beacon_receive_task_(),
       receiver_status_(ReceiverStatus::kSearchMode),
       major_(0),
-      sleep_deadline_ms_(0) {}
+      sleep_deadline_ms_(0),
+      warm_resume_(false),
+      first_frame_shown_(false),
+      first_beacon_shown_(false) {}
 
 BFoxReceiver::~BFoxReceiver() = default;
 
@@ -74,10 +132,96 @@ void BFoxReceiver::Start() {
   // Initialize Log
   logger::InitializeLogLevel();
 
+  ui_task_ = xTaskGetCurrentTaskHandle();
+
   ESP_LOGI(kTag, "Startup B-Fox Receiver. Version:%s",
            std::string(kGitVersion).c_str());
 
-  // Initialize NVS
+  // Warm resume from deep sleep, used once
+  warm_resume_ = (esp_reset_reason() == ESP_RST_DEEPSLEEP &&
+                  resume_state.magic == ResumeState::kMagic &&
+                  resume_state.major < kCourseNum);
+  resume_state.magic = 0;
+
+  // Light sleep whenever all tasks are blocked
+  power_manager_.Configure();
+
+  // One task runs the receive and button work, jobs are posted to its loop
+  event_loop_task_.Start();
+
+  // BLE comes up once the battery is known good, other peripherals
+  // initialize alongside
+  float voltage = 0.0f;
+  InitSequencer init_sequencer;
+  const InitSequencer::StageId nvs_stage =
+      init_sequencer.AddStage("nvs", [] { InitializeNvs(); });
+  const InitSequencer::StageId setting_stage = init_sequencer.AddStage(
+      "setting", [this] { LoadSetting(); }, {nvs_stage});
+  // The RF switch selects the external antenna before scanning starts
+  const InitSequencer::StageId antenna_stage =
+      init_sequencer.AddStage("antenna", [] { InitializeAntenna(); });
+  const InitSequencer::StageId battery_stage = init_sequencer.AddStage(
+      "battery", [this, &voltage] { voltage = GetBatteryVoltage(); });
+  // A discharged battery goes to sleep below without starting the radio
+  const InitSequencer::StageId ble_stage = init_sequencer.AddStage(
+      "ble",
+      [this, &voltage] {
+        if (!IsBatteryDischarged(voltage)) {
+          StartBeaconReceive();
+        }
+      },
+      {setting_stage, antenna_stage, battery_stage});
+  init_sequencer.AddStage("lcd", [this] { InitializeLcd(); });
+  // Button handlers use the receive task
+  init_sequencer.AddStage("gpio", [this] { InitializeGpio(); }, {ble_stage});
+  init_sequencer.Run();
+  init_sequencer.LogStageTimes();
+
+  // After the LCD stage, so the low battery notice can be shown
+  CheckBattery(voltage);
+  // Keep the filtered voltage current at a low duty
+  event_loop_task_.GetLoop()->StartTimer(&battery_start_timer_,
+                                         kBatteryRefreshIntervalMs,
+                                         kBatteryRefreshIntervalMs);
+
+#if CONFIG_BFOX_RECEIVER_PERF_CONSOLE
+  perf::StartConsole();
+#endif
+  if (kMessageQueueBenchEnabled) {
+    message_queue_bench_ = std::make_unique<MessageQueueBench>();
+    message_queue_bench_->Start();
+  }
+
+  if (!warm_resume_) {
+    // Initial LCD display
+    st7032_.SetCursor(0, 0);
+    st7032_.Print("B-Fox Receiver  ");
+    st7032_.SetCursor(0, 1);
+    st7032_.Printf(" Maj:%d Bat:%4.2fV", major_, voltage);
+  }
+
+  ESP_LOGI(kTag, "Activation Complete B-Fox Receiver System.");
+
+  // Set initial sleep deadline
+  sleep_deadline_ms_ = esp_timer_get_time() / 1000 + kSleepTimeoutMs;
+
+  if (!warm_resume_) {
+    // Initial screen until the first beacon (or a button)
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(kInitialWaitMs));
+  }
+
+  while (true) {
+    if (receiver_status_ == ReceiverStatus::kSearchMode) {
+      BeaconSearchMode();
+    } else if (receiver_status_ == ReceiverStatus::kSettingMode) {
+      SettingMode();
+    } else if (receiver_status_ == ReceiverStatus::kSettingFinishMode) {
+      SettingFinishMode();
+    }
+  }
+}
+
+void BFoxReceiver::InitializeNvs() {
   esp_err_t ret = nvs_flash_init();
   if (ret == ESP_ERR_NVS_NO_FREE_PAGES ||
       ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
@@ -86,55 +230,66 @@ void BFoxReceiver::Start() {
     ret = nvs_flash_init();
   }
   ESP_ERROR_CHECK(ret);
+}
 
-  // Get battery voltage
-  static const int32_t kVoltageAdcCheckRound = 10;
-  const uint32_t adc_voltage =
-      gpio::GetAdcVoltage(ADC_CHANNEL_0, kVoltageAdcCheckRound);
-  float voltage = 2.0f * adc_voltage / 1000.0f;
-
-  if (voltage <= kBatteryDischargeLimit) {
-    ESP_LOGW(kTag, "Battery Voltage is LOW. %4.2fV", voltage);
+float BFoxReceiver::GetBatteryVoltage() {
+  // The first DMA frame is enough here
+  if (!battery_monitor_.Start() ||
+      !battery_monitor_.WaitReady(kBatteryReadyTimeoutMs)) {
+    ESP_LOGE(kTag, "Battery monitor not ready");
+  }
+  // Refreshed periodically later, continuous ADC would hold off light sleep
+  battery_monitor_.Stop();
+  return battery_monitor_.GetVoltage();
+}
 
-    st7032_.SetCursor(0, 0);
-    st7032_.Printf("LowBattery:%4.2fV", voltage);
+void BFoxReceiver::InitializeAntenna() {
+  // Use Ext Antenna
+  gpio::InitOutput(xiao_esp32c6_pin::kWifiEnable,
+                   false);  // Activate RF switch control (kWifiEnable = False)
+  util::SleepMillisecond(100);
+  gpio::InitOutput(xiao_esp32c6_pin::kWifiAntConfig,
+                   true);  // Use external antenna (KWifiAntConfig = True)
+}
 
-    util::SleepMillisecond(3000);
-    st7032_.Clear();
-    esp_deep_sleep_start();
+void BFoxReceiver::LoadSetting() {
+  if (warm_resume_) {
+    major_ = resume_state.major;
+    return;
   }
-
-  // Read Setting
   ReceiverSetting setting;
   setting.Load();
   major_ = setting.GetMajor();
+}
 
+void BFoxReceiver::InitializeLcd() {
   // Initialize I2C
-  i2c_util::InitializeMaster(kI2cPortNo, xiao_esp32c6_pin::kSda,
-                             xiao_esp32c6_pin::kScl);
+  i2c_master_bus_handle_t i2c_bus = i2c_util::InitializeMaster(
+      kI2cPortNo, xiao_esp32c6_pin::kSda, xiao_esp32c6_pin::kScl);
 
-  // ST7032 (LCD Display)
-  st7032_.Setup(kI2cPortNo, ST7032::kI2cDefaultAddr, 16, 2);
-  st7032_.SetContrast(40);
-
-  // Initial LCD display
-  st7032_.SetCursor(0, 0);
-  st7032_.Print("B-Fox Receiver  ");
-  st7032_.SetCursor(0, 1);
-  st7032_.Printf(" Maj:%d Bat:%4.2fV", major_, voltage);
-
-  // Use Ext Antenna
-  gpio::InitOutput(xiao_esp32c6_pin::kWifiEnable,
-                   false);  // Activate RF switch control (kWifiEnable = False)
-  util::SleepMillisecond(100);
-  gpio::InitOutput(xiao_esp32c6_pin::kWifiAntConfig,
-                   true);  // Use external antenna (KWifiAntConfig = True)
+  // ST7032 (LCD Display), kept powered and initialized over deep sleep
+  if (warm_resume_ && resume_state.lcd_initialized) {
+    st7032_.Attach(i2c_bus, ST7032::kI2cDefaultAddr, 16, 2);
+  } else {
+    st7032_.Setup(i2c_bus, ST7032::kI2cDefaultAddr, 16, 2);
+    st7032_.SetContrast(40);
+  }
+}
 
-  // Set unused GPIOs to input with pull-up for stability
+void BFoxReceiver::InitializeGpio() {
+  // Set unused GPIOs to input with pull-down for stability, in one call
+  uint64_t unused_pin_mask = 0;
   for (const auto& gpio_num : kUnusedGpioPins) {
-    gpio_set_direction(gpio_num, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(gpio_num, GPIO_PULLDOWN_ONLY);
+    unused_pin_mask |= 1ULL << gpio_num;
   }
+  const gpio_config_t unused_pin_config = {
+      .pin_bit_mask = unused_pin_mask,
+      .mode = GPIO_MODE_INPUT,
+      .pull_up_en = GPIO_PULLUP_DISABLE,
+      .pull_down_en = GPIO_PULLDOWN_ENABLE,
+      .intr_type = GPIO_INTR_DISABLE,
+  };
+  gpio_config(&unused_pin_config);
 
   // Configure RTC pullup for kWakeupGpio first, then AddMonitor() (which calls
   // gpio_config() internally) will switch the pin back to Digital GPIO control.
@@ -154,34 +309,54 @@ void BFoxReceiver::Start() {
           kMajorChangeGpio, std::bind(&BFoxReceiver::OnSetMajorButton, this),
           std::bind(&BFoxReceiver::OnSetMajorLongButton, this)),
       GpioInputWatchTask::GpioPullUpDown::kPullUpResistorEnable);
-  gpio_watcher_.Start();
+  gpio_watcher_.EnableSleepWakeup();
+  gpio_watcher_.StartOn(event_loop_task_.GetLoop(), 0);
 
   esp_sleep_enable_ext1_wakeup((1ULL << kWakeupGpio), ESP_EXT1_WAKEUP_ANY_LOW);
+}
 
+void BFoxReceiver::StartBeaconReceive() {
   // Ble Receive Task
+  BeaconGroup groups[kCourseNum];
+  for (size_t course = 0; course < kCourseNum; ++course) {
+    std::memcpy(groups[course].proximity_uuid, kTargetProximityUuid,
+                sizeof(groups[course].proximity_uuid));
+    groups[course].major = course;
+    groups[course].adv_interval_ms = kCourseBeaconAdvIntervalMs;
+  }
   beacon_receive_task_ =
-      std::make_unique<BeaconReceiveTask>(kTargetProximityUuid, major_);
+      std::make_unique<BeaconReceiveTask>(groups, kCourseNum, major_,
+                                          kRssiFilterMode);
   if (!beacon_receive_task_) {
     return;
   }
-  beacon_receive_task_->Start();
-
-  ESP_LOGI(kTag, "Activation Complete B-Fox Receiver System.");
-
-  // Set initial sleep deadline
-  sleep_deadline_ms_ = esp_timer_get_time() / 1000 + kSleepTimeoutMs;
-
-  util::SleepMillisecond(2000);  // Initial wait time
-
-  while (true) {
-    if (receiver_status_ == ReceiverStatus::kSearchMode) {
-      BeaconSearchMode();
-    } else if (receiver_status_ == ReceiverStatus::kSettingMode) {
-      SettingMode();
-    } else if (receiver_status_ == ReceiverStatus::kSettingFinishMode) {
-      SettingFinishMode();
+  beacon_receive_task_->SetViewChangeNotifyTask(ui_task_);
+  beacon_receive_task_->SetPowerManager(&power_manager_);
+  if (warm_resume_) {
+    // Last known ranking is shown while scanning restarts; entries not heard
+    // again expire as usual
+    for (size_t i = 0; i < resume_state.item_count &&
+                       i < ResumeState::kMaxItemNum;
+         ++i) {
+      const ResumeItem& saved = resume_state.items[i];
+      BleBeaconItem item = {};
+      item.minor = saved.minor;
+      item.rssi = saved.rssi;
+      item.distance_cm = saved.distance_cm;
+      item.measured_power = saved.measured_power;
+      item.rssi_filter.Restore(saved.rssi_filter);
+      beacon_receive_task_->RestoreActiveItem(item);
     }
+    ESP_LOGI(kTag, "Warm resume. major:%d beacons:%u", major_,
+             resume_state.item_count);
   }
+  if (kScanTraceEnabled) {
+    scan_trace_recorder_ = std::make_unique<ScanTraceRecorder>();
+    scan_trace_recorder_->Start();
+    beacon_receive_task_->SetScanTraceRecorder(scan_trace_recorder_.get());
+  }
+  // Updates are requested by the task itself, no periodic wakeup
+  beacon_receive_task_->StartOn(event_loop_task_.GetLoop(), 0);
 }
 
 void BFoxReceiver::BeaconSearchMode() {
@@ -189,42 +364,127 @@ void BFoxReceiver::BeaconSearchMode() {
   const int64_t now_ms = esp_timer_get_time() / 1000;
   ESP_LOGI(kTag, "Sleep in %lldms", sleep_deadline_ms_.load() - now_ms);
   if (now_ms >= sleep_deadline_ms_) {
-    ESP_LOGI(kTag, "Sleep...");
-    st7032_.Clear();
-    esp_deep_sleep_start();
+    EnterDeepSleep();
   }
 
+  CheckBattery(battery_monitor_.GetVoltage());
+
+  LoadGlyphs();
+
   // Get and display iBeacon information
-  std::vector<BleBeaconItem> ble_beacon_list =
-      beacon_receive_task_->GetRSSISortedItems();
-  if (ble_beacon_list.empty()) {
-    st7032_.SetCursor(0, 0);
-    st7032_.Print("NO SIGNAL       ");
-    st7032_.SetCursor(0, 1);
-    st7032_.Print("                ");
-  } else {
-    for (int bleIdx = 0; bleIdx < kLcdDisplayLines; ++bleIdx) {
-      st7032_.SetCursor(0, bleIdx);
-      if (ble_beacon_list.size() <= bleIdx) {
-        st7032_.Print("                ");
-      } else {
-        const BleBeaconItem& info = ble_beacon_list[bleIdx];
-
-        st7032_.Printf("%d|", info.minor);
-        for (int indicator_idx = 0; indicator_idx < kIndicatorRssiNum;
-             ++indicator_idx) {
-          if (kIndicatorRssiTargets[indicator_idx] < info.rssi) {
-            st7032_.Printf("#");
-          } else {
-            st7032_.Printf(" ");
-          }
-        }
-        st7032_.Printf("|%-4ddBm", info.rssi);
-      }
+  BeaconReceiveTask::RankedItems ranked_items;
+  {
+    // Render and queue the I2C transfers (they complete asynchronously)
+    perf::ScopedTimer frame_timer(&lcd_frame_histogram);
+    beacon_receive_task_->GetRankedItems(&ranked_items);
+    search_view::Frame frame;
+    search_view::Render(ranked_items, &frame);
+    for (int line = 0; line < kLcdDisplayLines; ++line) {
+      st7032_.SetCursor(0, line);
+      st7032_.Write(frame.rows[line], search_view::kLcdCols);
     }
   }
+  // Times since the application started (ROM and bootloader not included)
+  if (!first_frame_shown_) {
+    ESP_LOGI(kTag, "First frame %lldms after boot (%s)",
+             esp_timer_get_time() / 1000, warm_resume_ ? "warm" : "cold");
+    first_frame_shown_ = true;
+  }
+  if (!first_beacon_shown_ && ranked_items.count != 0) {
+    ESP_LOGI(kTag, "First beacon displayed %lldms after boot (%s)",
+             esp_timer_get_time() / 1000, warm_resume_ ? "warm" : "cold");
+    first_beacon_shown_ = true;
+  }
+
+  // Limit the frame rate, then sleep until the view changes, a button is
+  // pressed or the sleep deadline comes
+  util::SleepMillisecond(kMinFrameIntervalMs);
+  const int64_t wait_ms =
+      sleep_deadline_ms_.load() - esp_timer_get_time() / 1000;
+  if (wait_ms > 0) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
+  }
+}
 
-  util::SleepMillisecond(500);
+void BFoxReceiver::LoadGlyphs() {
+  // No I2C traffic unless the CGRAM holds other glyphs
+  uint8_t pattern[GlyphManager::kGlyphRows];
+  for (int fill = 1; fill <= rssi_indicator::kGlyphNum; ++fill) {
+    rssi_indicator::MakeGlyph(fill, pattern);
+    glyph_manager_.Load(rssi_indicator::kGlyphCodeBase + fill - 1, pattern);
+  }
+  glyph_manager_.Load(rssi_indicator::kApproachingCode,
+                      rssi_indicator::kApproachingGlyph);
+  glyph_manager_.Load(rssi_indicator::kRecedingCode,
+                      rssi_indicator::kRecedingGlyph);
+}
+
+void BFoxReceiver::CheckBattery(const float voltage) {
+  if (IsBatteryDischarged(voltage)) {
+    ESP_LOGW(kTag, "Battery Voltage is LOW. %4.2fV", voltage);
+
+    st7032_.SetCursor(0, 0);
+    st7032_.Printf("LowBattery:%4.2fV", voltage);
+
+    util::SleepMillisecond(3000);
+    st7032_.Clear();
+    esp_deep_sleep_start();
+  }
+}
+
+void BFoxReceiver::OnBatterySampleStart(void* const arg) {
+  BFoxReceiver* const self = static_cast<BFoxReceiver*>(arg);
+  if (!self->battery_monitor_.Start()) {
+    // Not retried, a failed Start leaves the monitor unusable
+    ESP_LOGE(kTag, "Battery monitor not started");
+    self->event_loop_task_.GetLoop()->StopTimer(&self->battery_start_timer_);
+    return;
+  }
+  self->event_loop_task_.GetLoop()->StartTimer(&self->battery_done_timer_,
+                                               kBatterySampleMs);
+}
+
+void BFoxReceiver::OnBatterySampleDone(void* const arg) {
+  BFoxReceiver* const self = static_cast<BFoxReceiver*>(arg);
+  self->battery_monitor_.Stop();
+  const float voltage = self->battery_monitor_.GetVoltage();
+  ESP_LOGI(kTag, "Battery %4.2fV %u%%", voltage,
+           self->battery_monitor_.GetStateOfCharge());
+  // The UI loop checks the new value
+  if (IsBatteryDischarged(voltage)) {
+    self->WakeUi();
+  }
+}
+
+void BFoxReceiver::EnterDeepSleep() {
+  ESP_LOGI(kTag, "Sleep...");
+  if (scan_trace_recorder_) {
+    scan_trace_recorder_->Close();
+  }
+  SaveResumeState();
+  st7032_.Clear();
+  esp_deep_sleep_start();
+}
+
+void BFoxReceiver::SaveResumeState() {
+  resume_state.major = major_;
+  resume_state.lcd_initialized = st7032_.IsAttached();  // cleared next
+  resume_state.item_count = 0;
+  if (!beacon_receive_task_) {
+    resume_state.magic = ResumeState::kMagic;
+    return;
+  }
+  beacon_receive_task_->ForEachActiveItem([](const BleBeaconItem& item) {
+    if (resume_state.item_count < ResumeState::kMaxItemNum) {
+      resume_state.items[resume_state.item_count++] = {
+          .minor = item.minor,
+          .measured_power = item.measured_power,
+          .rssi = item.rssi,
+          .distance_cm = item.distance_cm,
+          .rssi_filter = item.rssi_filter.Save()};
+    }
+  });
+  resume_state.magic = ResumeState::kMagic;
 }
 
 void BFoxReceiver::SettingMode() {
@@ -238,6 +498,9 @@ void BFoxReceiver::SettingMode() {
 
     util::SleepMillisecond(1900);
     ESP_LOGI(kTag, "Sleep...");
+    if (scan_trace_recorder_) {
+      scan_trace_recorder_->Close();
+    }
     st7032_.Clear();
     util::SleepMillisecond(100);
     esp_restart();
@@ -246,7 +509,8 @@ void BFoxReceiver::SettingMode() {
   st7032_.SetCursor(0, 0);
   st7032_.Print("Setting Mode    ");
   st7032_.SetCursor(0, 1);
-  st7032_.Printf(" Major:%d        ", major_);
+  st7032_.Printf(" Major:%d Bcn:%-3u", major_,
+                 beacon_receive_task_->GetGroupOccupancy(major_));
 
   util::SleepMillisecond(100);
 }
@@ -256,20 +520,27 @@ void BFoxReceiver::SettingFinishMode() {
   setting.SetMajor(major_);
   setting.Save();
 
+  // Switch the displayed group, scanning keeps running
+  beacon_receive_task_->SetActiveGroup(major_);
+
   st7032_.SetCursor(0, 0);
   st7032_.Printf("Saved Major:%d   ", major_);
   st7032_.SetCursor(0, 1);
-  st7032_.Print(" Restart...     ");
+  st7032_.Print("                ");
 
-  util::SleepMillisecond(1900);
-  ESP_LOGI(kTag, "Restart");
-  util::SleepMillisecond(100);
-  esp_restart();
+  util::SleepMillisecond(1000);
+  ESP_LOGI(kTag, "Active major:%d", major_);
+  sleep_deadline_ms_ = esp_timer_get_time() / 1000 + kSleepTimeoutMs;
+  receiver_status_ = ReceiverStatus::kSearchMode;
 }
 
 void BFoxReceiver::OnActivityButton() {
   ESP_LOGI(kTag, "OnActivityButton: extend sleep deadline");
   sleep_deadline_ms_ = esp_timer_get_time() / 1000 + kSleepTimeoutMs;
+  if (beacon_receive_task_) {
+    beacon_receive_task_->RequestFastScan();
+  }
+  WakeUi();
 }
 
 void BFoxReceiver::OnSetMajorButton() {
@@ -278,8 +549,9 @@ void BFoxReceiver::OnSetMajorButton() {
   if (receiver_status_ == ReceiverStatus::kSearchMode) {
     receiver_status_ = ReceiverStatus::kSettingMode;
   } else if (receiver_status_ == ReceiverStatus::kSettingMode) {
-    major_ = (major_ + 1) % 10;
+    major_ = (major_ + 1) % kCourseNum;
   }
+  WakeUi();
 }
 
 void BFoxReceiver::OnSetMajorLongButton() {
@@ -287,6 +559,13 @@ void BFoxReceiver::OnSetMajorLongButton() {
   if (receiver_status_ == ReceiverStatus::kSettingMode) {
     receiver_status_ = ReceiverStatus::kSettingFinishMode;
   }
+  WakeUi();
+}
+
+void BFoxReceiver::WakeUi() {
+  if (ui_task_ != nullptr) {
+    xTaskNotifyGive(ui_task_);
+  }
 }
 
 }  // namespace bfox_receiver_system
@@ -8,9 +8,14 @@
 #include <cstdint>
 #include <memory>
 
+#include "battery_monitor.h"
 #include "beacon_receive_task.h"
 #include "bfox_receiver_interface.h"
+#include "event_loop_task.h"
+#include "glyph_manager.h"
 #include "gpio_input_watch_task.h"
+#include "message_queue_bench.h"
+#include "power_manager.h"
 #include "st7032.h"
 
 namespace bfox_receiver_system {
@@ -32,21 +37,59 @@ class BFoxReceiver final : public BFoxReceiverInterface,
   void Start();
 
  private:
+  // Boot stages (run by InitSequencer)
+  static void InitializeNvs();
+  float GetBatteryVoltage();
+  static void InitializeAntenna();
+  void LoadSetting();
+  void InitializeLcd();
+  void InitializeGpio();
+  void StartBeaconReceive();
+
   void BeaconSearchMode();
   void SettingMode();
   void SettingFinishMode();
 
+  void LoadGlyphs();
+
+  /// Deep sleep (after a notice on the LCD) if the battery is discharged
+  void CheckBattery(const float voltage);
+
+  /// Battery refresh on the event loop: sample a few DMA frames, then stop
+  /// the ADC again (it holds off light sleep while running)
+  static void OnBatterySampleStart(void* const arg);
+  static void OnBatterySampleDone(void* const arg);
+
+  /// Save the search state to RTC memory, clear the LCD and deep sleep
+  void EnterDeepSleep();
+  void SaveResumeState();
+
   void OnActivityButton();
   void OnSetMajorButton();
   void OnSetMajorLongButton();
 
+  /// Wake the UI loop waiting for a view change
+  void WakeUi();
+
  private:
+  TaskHandle_t ui_task_;  // task running Start()
+  EventLoopTask event_loop_task_;  // hosts the receive and button tasks
   GpioInputWatchTask gpio_watcher_;
   ST7032 st7032_;
+  GlyphManager glyph_manager_;
+  BatteryMonitor battery_monitor_;
+  EventLoop::Timer battery_start_timer_;  // periodic
+  EventLoop::Timer battery_done_timer_;   // one shot, after each start
+  PowerManager power_manager_;
+  ScanTraceRecorderUniquePtr scan_trace_recorder_;
+  MessageQueueBenchUniquePtr message_queue_bench_;
   BeaconReceiveTaskUniquePtr beacon_receive_task_;
   ReceiverStatus receiver_status_;
   uint16_t major_;
   std::atomic<int64_t> sleep_deadline_ms_;  // absolute time (ms) to enter Deep Sleep
+  bool warm_resume_;  // woke from deep sleep with a saved state
+  bool first_frame_shown_;
+  bool first_beacon_shown_;
 };
 
 }  // namespace bfox_receiver_system
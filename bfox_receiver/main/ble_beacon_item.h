@@ -4,18 +4,21 @@
 // (C)2025 bekki.jp
 
 #include <cstdint>
-#include <tuple>
+
+#include "rssi_filter.h"
+#include "rssi_trend.h"
 
 namespace bfox_receiver_system {
 
 struct BleBeaconItem {
   uint16_t minor;
-  int32_t rssi;
-  int64_t last_seen_ms;  // timestamp in ms (esp_timer_get_time() / 1000)
-
-  bool operator<(const BleBeaconItem& other) const {
-    return std::tie(minor) < std::tie(other.minor);
-  }
+  int32_t rssi;           // filtered RSSI [dBm]
+  int64_t last_seen_ms;   // timestamp in ms (esp_timer_get_time() / 1000)
+  uint32_t distance_cm;   // estimated from filtered RSSI
+  int8_t measured_power;  // advertised RSSI @1m [dBm]
+  RssiFilter rssi_filter;
+  RssiTrend rssi_trend;  // fed with raw RSSI
+  RssiTrend::Direction trend;
 };
 
 }  // namespace bfox_receiver_system
@@ -0,0 +1,78 @@
+#ifndef BFOX_RECEIVER_MAIN_DISTANCE_ESTIMATOR_H_
+#define BFOX_RECEIVER_MAIN_DISTANCE_ESTIMATOR_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstdint>
+
+namespace bfox_receiver_system {
+namespace distance_estimator {
+
+/// Used when the beacon does not advertise a valid measured power (RSSI @1m)
+constexpr int32_t kDefaultMeasuredPower = -59;
+
+/// Free space = 2.0, indoor/obstructed 2.5 - 4.0 (scaled by 10)
+constexpr int32_t kDefaultPathLossExponentX10 = 20;
+
+constexpr uint32_t kMaxDistanceCm = 99900;
+
+/// Log-distance path loss model
+///   d = 10 ^ ((measured_power - rssi) / (10 * n))  [m]
+/// Integer only: the exponent is evaluated in 1/100 decades and the fraction
+/// looked up from a table of 10^(i/100).
+inline uint32_t EstimateDistanceCm(int32_t measured_power, const int32_t rssi,
+                                   const int32_t path_loss_exponent_x10) {
+  // 1000 * 10^(i/100)
+  static constexpr uint16_t kPow10Table[100] = {
+      1000, 1023, 1047, 1072, 1096, 1122, 1148, 1175, 1202, 1230,
+      1259, 1288, 1318, 1349, 1380, 1413, 1445, 1479, 1514, 1549,
+      1585, 1622, 1660, 1698, 1738, 1778, 1820, 1862, 1905, 1950,
+      1995, 2042, 2089, 2138, 2188, 2239, 2291, 2344, 2399, 2455,
+      2512, 2570, 2630, 2692, 2754, 2818, 2884, 2951, 3020, 3090,
+      3162, 3236, 3311, 3388, 3467, 3548, 3631, 3715, 3802, 3890,
+      3981, 4074, 4169, 4266, 4365, 4467, 4571, 4677, 4786, 4898,
+      5012, 5129, 5248, 5370, 5495, 5623, 5754, 5888, 6026, 6166,
+      6310, 6457, 6607, 6761, 6918, 7079, 7244, 7413, 7586, 7762,
+      7943, 8128, 8318, 8511, 8710, 8913, 9120, 9333, 9550, 9772,
+  };
+
+  if (measured_power >= 0) {
+    measured_power = kDefaultMeasuredPower;
+  }
+  if (path_loss_exponent_x10 <= 0) {
+    return kMaxDistanceCm;
+  }
+
+  // Exponent in 1/100 decades, split into integer decade and fraction
+  int32_t centi_decades =
+      (measured_power - rssi) * 100 / path_loss_exponent_x10;
+  int32_t decades = centi_decades / 100;
+  int32_t fraction = centi_decades % 100;
+  if (fraction < 0) {
+    fraction += 100;
+    --decades;
+  }
+
+  // 100cm * 10^(fraction/100) = kPow10Table[fraction] / 10
+  uint32_t distance_cm = kPow10Table[fraction];
+  if (decades < 0) {
+    for (; decades < 0; ++decades) {
+      distance_cm /= 10;
+    }
+    return distance_cm / 10;
+  }
+  for (; 0 < decades; --decades) {
+    distance_cm *= 10;
+    if (kMaxDistanceCm * 10 < distance_cm) {
+      return kMaxDistanceCm;
+    }
+  }
+  distance_cm /= 10;
+  return (kMaxDistanceCm < distance_cm) ? kMaxDistanceCm : distance_cm;
+}
+
+}  // namespace distance_estimator
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_DISTANCE_ESTIMATOR_H_
@@ -0,0 +1,34 @@
+#ifndef BFOX_RECEIVER_MAIN_EVENT_LOOP_TASK_H_
+#define BFOX_RECEIVER_MAIN_EVENT_LOOP_TASK_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "event_loop.h"
+#include "task.h"
+
+namespace bfox_receiver_system {
+
+/// Task hosting an EventLoop for the tasks started with StartOn
+class EventLoopTask final : public StaticTask<EventLoopTask> {
+ public:
+  static constexpr const char* kTaskName = "EventLoopTask";
+  static constexpr int kPriority = Task::kPriorityLow;
+  static constexpr int kCoreId = tskNO_AFFINITY;
+  static constexpr uint32_t kStackDepth = 4096;  // [byte] NimBLE init
+
+ public:
+  EventLoopTask() : StaticTask(kTaskName, kPriority, kCoreId), loop_() {}
+
+  void Update() override { loop_.RunOnce(); }
+
+  /// Usable before Start, posted work waits until the task runs
+  EventLoop* GetLoop() { return &loop_; }
+
+ private:
+  EventLoop loop_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_EVENT_LOOP_TASK_H_
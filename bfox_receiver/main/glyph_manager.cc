@@ -0,0 +1,37 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "glyph_manager.h"
+
+#include <cstring>
+
+#include "logger.h"
+
+namespace bfox_receiver_system {
+
+GlyphManager::GlyphManager(ST7032& lcd)
+    : lcd_(lcd), loaded_(), loaded_mask_(0), upload_count_(0) {}
+
+bool GlyphManager::Load(const uint8_t code,
+                        const uint8_t pattern[kGlyphRows]) {
+  if (code >= kGlyphNum) {
+    ESP_LOGW(kTag, "Invalid glyph code: %u", code);
+    return false;
+  }
+  const uint8_t bit = 1u << code;
+  if ((loaded_mask_ & bit) != 0 &&
+      std::memcmp(loaded_[code], pattern, kGlyphRows) == 0) {
+    return false;
+  }
+
+  lcd_.CreateChar(code, pattern);
+  std::memcpy(loaded_[code], pattern, kGlyphRows);
+  loaded_mask_ |= bit;
+  ++upload_count_;
+  return true;
+}
+
+void GlyphManager::Invalidate() { loaded_mask_ = 0; }
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,43 @@
+#ifndef BFOX_RECEIVER_MAIN_GLYPH_MANAGER_H_
+#define BFOX_RECEIVER_MAIN_GLYPH_MANAGER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstdint>
+
+#include "st7032.h"
+
+namespace bfox_receiver_system {
+
+/// Custom characters in the ST7032 CGRAM (codes 0-7).
+///
+/// Remembers the pattern loaded in each code and only writes the CGRAM when
+/// the pattern changes, so redrawing with the same glyph set costs no I2C
+/// traffic.
+class GlyphManager final {
+ public:
+  static constexpr uint8_t kGlyphNum = 8;
+  static constexpr uint8_t kGlyphRows = 8;  // 5x8 dots
+
+ public:
+  explicit GlyphManager(ST7032& lcd);
+
+  /// Load a pattern into a code. Returns true if the CGRAM was written.
+  bool Load(const uint8_t code, const uint8_t pattern[kGlyphRows]);
+
+  /// Forget the cache (LCD was reset)
+  void Invalidate();
+
+  uint32_t GetUploadCount() const { return upload_count_; }
+
+ private:
+  ST7032& lcd_;
+  uint8_t loaded_[kGlyphNum][kGlyphRows];
+  uint8_t loaded_mask_;  // bit n: loaded_[n] is valid
+  uint32_t upload_count_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_GLYPH_MANAGER_H_
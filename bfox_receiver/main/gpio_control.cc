@@ -5,9 +5,6 @@
 #include "gpio_control.h"
 
 #include <driver/gpio.h>
-#include <esp_adc/adc_cali.h>
-#include <esp_adc/adc_cali_scheme.h>
-#include <esp_adc/adc_oneshot.h>
 
 #include "logger.h"
 
@@ -58,54 +55,5 @@ bool GetLevel(const gpio_num_t gpio_number) {
   return gpio_get_level(gpio_number) != 0;
 }
 
-/// Get ADC Voltage (Input) [mV]
-uint32_t GetAdcVoltage(const int32_t adc_channel_no, const int32_t round) {
-  adc_oneshot_unit_handle_t adc_handle;
-  adc_oneshot_unit_init_cfg_t adcInitConfig = {
-      .unit_id = ADC_UNIT_1,
-      .clk_src = static_cast<adc_oneshot_clk_src_t>(ADC_DIGI_CLK_SRC_DEFAULT),
-      .ulp_mode = ADC_ULP_MODE_DISABLE,
-  };
-  adc_oneshot_new_unit(&adcInitConfig, &adc_handle);
-
-  adc_oneshot_chan_cfg_t adc_config = {
-      .atten = ADC_ATTEN_DB_12,
-      .bitwidth = ADC_BITWIDTH_12,
-  };
-  adc_oneshot_config_channel(
-      adc_handle, static_cast<adc_channel_t>(adc_channel_no), &adc_config);
-
-  adc_cali_handle_t adc_cali_handle = nullptr;
-  adc_cali_curve_fitting_config_t cali_config = {
-      .unit_id = ADC_UNIT_1,
-      .chan = static_cast<adc_channel_t>(adc_channel_no),
-      .atten = ADC_ATTEN_DB_12,
-      .bitwidth = ADC_BITWIDTH_DEFAULT,
-  };
-  esp_err_t ret =
-      adc_cali_create_scheme_curve_fitting(&cali_config, &adc_cali_handle);
-  if (ret != ESP_OK) {
-    adc_oneshot_del_unit(adc_handle);
-    return 0;
-  }
-
-  uint32_t sum_voltage = 0;
-  for (int32_t i = 0; i < round; ++i) {
-    int32_t adcValue = 0;
-    adc_oneshot_read(adc_handle, static_cast<adc_channel_t>(adc_channel_no),
-                     reinterpret_cast<int*>(&adcValue));
-    int32_t adcVoltage = 0;
-    adc_cali_raw_to_voltage(adc_cali_handle, adcValue,
-                            reinterpret_cast<int*>(&adcVoltage));
-    sum_voltage += adcVoltage;
-  }
-
-  // Shutdown
-  adc_oneshot_del_unit(adc_handle);
-  adc_cali_delete_scheme_curve_fitting(adc_cali_handle);
-
-  return sum_voltage / round;
-}
-
 }  // namespace gpio
 }  // namespace bfox_receiver_system
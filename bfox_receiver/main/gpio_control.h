@@ -28,9 +28,6 @@ void SetLevel(const gpio_num_t gpio_number, const bool level);
 /// Gett GPIO Level (Input)
 bool GetLevel(const gpio_num_t gpio_number);
 
-/// Get ADC Voltage (Input) [mV]
-uint32_t GetAdcVoltage(const int32_t adc_channel_no, const int32_t round = 1);
-
 }  // namespace gpio
 }  // namespace bfox_receiver_system
 
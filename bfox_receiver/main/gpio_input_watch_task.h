@@ -5,6 +5,7 @@
 
 // Include ----------------------
 #include <driver/gpio.h>
+#include <esp_sleep.h>
 #include <freertos/FreeRTOS.h>
 
 #include <functional>
@@ -12,11 +13,12 @@
 
 #include "gptimer.h"
 #include "logger.h"
-#include "message_queue.h"
 #include "task.h"
 
 namespace bfox_receiver_system {
 
+/// Runs on an EventLoop (StartOn); interrupts and the sampling timer post
+/// their work to the loop.
 class GpioInputWatchTask final : public Task {
  public:
   static constexpr std::string_view kTaskName = "GpioInputWatchTask";
@@ -26,6 +28,7 @@ class GpioInputWatchTask final : public Task {
  private:
   static constexpr int32_t kEdgeCounter = 3;
   static constexpr int32_t kLongEdgeCounter = 100;
+  static constexpr uint64_t kCheckIntervalUs = 5000;  // 5ms per counter step
 
  public:
   enum class GpioPullUpDown {
@@ -53,6 +56,12 @@ class GpioInputWatchTask final : public Task {
 
     gpio_num_t GetGpioNo() const { return gpio_no_; }
 
+    /// Pressed, still counting or waiting for release
+    bool IsActive() const {
+      return status_ != Status::kStatusDisable || input_counter_ != 0 ||
+             gpio_get_level(gpio_no_) == 0;
+    }
+
     void Check() {
       if (status_ == Status::kStatusDisable) {
         if (gpio_get_level(gpio_no_) == 0) {
@@ -94,47 +103,41 @@ class GpioInputWatchTask final : public Task {
  public:
   GpioInputWatchTask()
       : Task(std::string(kTaskName).c_str(), kPriority, kCoreId),
-        message_queue_(),
         gptimer_(),
-        gpio_list_() {
-    // Create MessageQueue
-    constexpr int32_t kMessageQueueSize = 10;
-    if (!message_queue_.Create(kMessageQueueSize)) {
-      ESP_LOGE(kTag, "Creating queue failed");
-    }
-
+        gpio_list_(),
+        checking_(false) {
     // Create Timer
     constexpr uint32_t kGpioWatchResolution = 1000000u;  // 1us
     gptimer_.Create(kGpioWatchResolution, &GpioInputWatchTask::TimerCallback,
-                    &message_queue_);
+                    this);
   }
 
-  ~GpioInputWatchTask() {
-    gptimer_.Destroy();
-    message_queue_.Destroy();
-  }
+  ~GpioInputWatchTask() { gptimer_.Destroy(); }
 
   void Initialize() override {
     ESP_LOGI(kTag, "Start GpioInputWatchTask");
     gpio_install_isr_service(0);
+    for (auto&& gpio_info : gpio_list_) {
+      gpio_isr_handler_add(gpio_info.GetGpioNo(),
+                           &GpioInputWatchTask::EdgeIsr, this);
+    }
+    // A button held during startup gives no edge
+    StartCheck();
   }
 
-  void Update() override {
-    gptimer_.Start(5000);  // 5ms
-    int event_type = 0;
-    while (true) {
-      constexpr int32_t kQueueReceiveLimit =
-          1000 / portTICK_PERIOD_MS;  // Maximum wait tick
-      if (message_queue_.ReceiveWait(&event_type, kQueueReceiveLimit)) {
-        if (event_type == 1) {
-          for (auto&& gpio_info : gpio_list_) {
-            gpio_info.Check();
-          }
-        }
-      }
+  /// Work is posted by the interrupts, nothing periodic
+  void Update() override {}
+
+  /// Let the buttons (active low) wake the CPU from light sleep. The pin
+  /// interrupts become low level, the ISR disables them until release.
+  void EnableSleepWakeup() {
+    for (auto&& gpio_info : gpio_list_) {
+      gpio_wakeup_enable(gpio_info.GetGpioNo(), GPIO_INTR_LOW_LEVEL);
     }
+    esp_sleep_enable_gpio_wakeup();
   }
 
+  /// Call before Start
   void AddMonitor(GpioInfo gpio_info,
                   GpioPullUpDown gpio_pullupdown = GpioPullUpDown::kNone) {
     // Setting GPIO Input
@@ -157,17 +160,77 @@ class GpioInputWatchTask final : public Task {
   }
 
  private:
+  /// Idle until a pin interrupt, then sample every 5ms while any button is
+  /// bouncing or held. The timer is stopped and disabled again once all are
+  /// released, so it holds no power management lock while idle.
+  void Check() {
+    if (!checking_) {
+      return;
+    }
+    bool active = false;
+    for (auto&& gpio_info : gpio_list_) {
+      gpio_info.Check();
+      active |= gpio_info.IsActive();
+    }
+    if (!active) {
+      StopCheck();
+    }
+  }
+
+  void StartCheck() {
+    if (!checking_) {
+      checking_ = true;
+      gptimer_.Start(kCheckIntervalUs);
+    }
+  }
+
+  void StopCheck() {
+    gptimer_.Stop();
+    checking_ = false;
+    for (auto&& gpio_info : gpio_list_) {
+      gpio_intr_enable(gpio_info.GetGpioNo());
+    }
+    // A press between the last check and enabling the interrupt has no edge
+    for (auto&& gpio_info : gpio_list_) {
+      if (gpio_info.IsActive()) {
+        StartCheck();
+        return;
+      }
+    }
+  }
+
+  static void EdgeIsr(void* const arg) {
+    GpioInputWatchTask* const self = static_cast<GpioInputWatchTask*>(arg);
+    // Bounces are sampled by the timer, not counted as interrupts
+    for (auto&& gpio_info : self->gpio_list_) {
+      gpio_intr_disable(gpio_info.GetGpioNo());
+    }
+    self->GetEventLoop()->PostFromISR(&GpioInputWatchTask::OnEdge, self);
+  }
+
   static bool TimerCallback(gptimer_handle_t timer,
                             const gptimer_alarm_event_data_t* event_data,
-                            void* message_queue) {
-    MessageQueue<int>* queue = static_cast<MessageQueue<int>*>(message_queue);
-    return queue->SendFromISR(1);
+                            void* arg) {
+    GpioInputWatchTask* const self = static_cast<GpioInputWatchTask*>(arg);
+    // The driver yields on the returned flag
+    BaseType_t high_task_awoken = pdFALSE;
+    self->GetEventLoop()->PostFromISR(&GpioInputWatchTask::OnCheck, self,
+                                      &high_task_awoken);
+    return high_task_awoken == pdTRUE;
+  }
+
+  static void OnEdge(void* const arg) {
+    static_cast<GpioInputWatchTask*>(arg)->StartCheck();
+  }
+
+  static void OnCheck(void* const arg) {
+    static_cast<GpioInputWatchTask*>(arg)->Check();
   }
 
  private:
-  MessageQueue<int> message_queue_;
   GPTimer gptimer_;
   std::vector<GpioInfo> gpio_list_;
+  bool checking_;  // timer running, pin interrupts disabled
 };
 
 }  // namespace bfox_receiver_system
@@ -12,7 +12,7 @@ namespace bfox_receiver_system {
 
 class GPTimer {
  public:
-  GPTimer() : gptimer_(nullptr) {}
+  GPTimer() : gptimer_(nullptr), enabled_(false) {}
 
   ~GPTimer() { Destroy(); }
 
@@ -30,41 +30,50 @@ class GPTimer {
     // SetCallback
     gptimer_event_callbacks_t gptimer_callback = {.on_alarm = function};
     gptimer_register_event_callbacks(gptimer_, &gptimer_callback, user_data);
-
-    // Enable
-    gptimer_enable(gptimer_);
   }
 
   void Destroy() {
     if (gptimer_) {
-      gptimer_disable(gptimer_);
+      Stop();
       gptimer_del_timer(gptimer_);
       gptimer_ = nullptr;
     }
   }
 
+  /// Enabled only while running: an enabled timer holds the driver's power
+  /// management lock (its PLL clock source), which blocks light sleep.
   void Start(const uint64_t wait_count) const {
     if (!gptimer_) {
       return;
     }
+    if (enabled_) {
+      gptimer_stop(gptimer_);
+    } else {
+      gptimer_enable(gptimer_);
+      enabled_ = true;
+    }
 
     gptimer_alarm_config_t alarm_config = {.alarm_count = wait_count,
                                            .reload_count = 0ull,
                                            .flags{.auto_reload_on_alarm = 1u}};
     gptimer_set_alarm_action(gptimer_, &alarm_config);
+    gptimer_set_raw_count(gptimer_, 0);  // full period after a restart
     gptimer_start(gptimer_);
   }
 
   void Stop() const {
-    if (!gptimer_) {
+    if (!gptimer_ || !enabled_) {
       return;
     }
     gptimer_stop(gptimer_);
+    gptimer_disable(gptimer_);
+    enabled_ = false;
   }
 
  private:
   // Mutable to allow const methods to call ESP-IDF driver functions
   mutable gptimer_handle_t gptimer_;
+  mutable bool enabled_;
 };
 
 }  // namespace bfox_receiver_system
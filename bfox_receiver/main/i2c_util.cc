@@ -5,24 +5,30 @@
 // Include ----------------------
 #include "i2c_util.h"
 
+#include "logger.h"
+
 namespace bfox_receiver_system {
 namespace i2c_util {
 
-void InitializeMaster(const i2c_port_t port, const gpio_num_t sda_pin,
-                      const gpio_num_t scl_pin) {
-  constexpr i2c_mode_t mode = I2C_MODE_MASTER;
-  constexpr uint32_t i2c_master_freq_hz = 100000;
-
-  i2c_config_t config = {};
-  config.mode = mode;
+i2c_master_bus_handle_t InitializeMaster(const i2c_port_t port,
+                                         const gpio_num_t sda_pin,
+                                         const gpio_num_t scl_pin) {
+  i2c_master_bus_config_t config = {};
+  config.i2c_port = port;
   config.sda_io_num = sda_pin;
   config.scl_io_num = scl_pin;
-  config.scl_pullup_en = true;
-  config.sda_pullup_en = true;
-  config.master.clk_speed = i2c_master_freq_hz;
+  config.clk_source = I2C_CLK_SRC_DEFAULT;
+  config.glitch_ignore_cnt = 7;
+  config.trans_queue_depth = kTransQueueDepth;  // enables asynchronous mode
+  config.flags.enable_internal_pullup = true;
 
-  i2c_param_config(port, &config);
-  i2c_driver_install(port, mode, 0, 0, 0);
+  i2c_master_bus_handle_t bus_handle = nullptr;
+  const esp_err_t ret = i2c_new_master_bus(&config, &bus_handle);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "i2c_new_master_bus failed: %s", esp_err_to_name(ret));
+    return nullptr;
+  }
+  return bus_handle;
 }
 
 }  // namespace i2c_util
@@ -6,13 +6,20 @@
 
 // Include ----------------------
 #include <driver/gpio.h>
-#include <driver/i2c.h>
+#include <driver/i2c_master.h>
+
+#include <cstdint>
 
 namespace bfox_receiver_system {
 namespace i2c_util {
 
-void InitializeMaster(const i2c_port_t port, const gpio_num_t sda_pin,
-                      const gpio_num_t scl_pin);
+/// Transfers queued per bus before i2c_master_transmit blocks
+constexpr size_t kTransQueueDepth = 16;
+
+/// Create an I2C master bus (asynchronous transfers). nullptr on failure.
+i2c_master_bus_handle_t InitializeMaster(const i2c_port_t port,
+                                         const gpio_num_t sda_pin,
+                                         const gpio_num_t scl_pin);
 
 }  // namespace i2c_util
 }  // namespace bfox_receiver_system
@@ -0,0 +1,140 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "init_sequencer.h"
+
+#include <esp_timer.h>
+#include <freertos/task.h>
+
+#include "logger.h"
+
+#include "task.h"
+
+namespace bfox_receiver_system {
+
+/// Runs stages until none is left, then ends. One instance per lane, each
+/// lane has its own static stack.
+template <int kLane>
+class InitStageWorker final : public StaticTask<InitStageWorker<kLane>> {
+ public:
+  static constexpr const char* kTaskName = "InitStage";
+  static constexpr uint32_t kStackDepth = InitSequencer::kStageStackDepth;
+
+ public:
+  InitStageWorker(InitSequencer* const sequencer, const int32_t priority)
+      : StaticTask<InitStageWorker<kLane>>(kTaskName, priority,
+                                           tskNO_AFFINITY),
+        sequencer_(sequencer) {}
+
+  void Update() override {
+    if (!sequencer_->RunNextStage()) {
+      // The sequencer may be gone once the bit is set
+      this->Stop();
+      xEventGroupSetBits(sequencer_->done_events_,
+                         InitSequencer::WorkerDoneBit(kLane));
+    }
+  }
+
+ private:
+  InitSequencer* sequencer_;
+};
+
+InitSequencer::InitSequencer()
+    : stages_(), stage_num_(0), next_stage_(0), done_events_(nullptr) {}
+
+InitSequencer::~InitSequencer() {
+  if (done_events_ != nullptr) {
+    vEventGroupDelete(done_events_);
+  }
+}
+
+InitSequencer::StageId InitSequencer::AddStage(
+    const char* const name, const StageFunction& function,
+    std::initializer_list<StageId> depends_on) {
+  if (stage_num_ >= kMaxStageNum) {
+    ESP_LOGE(kTag, "Too many init stages: %s", name);
+    return -1;
+  }
+  Stage& stage = stages_[stage_num_];
+  stage.sequencer = this;
+  stage.name = name;
+  stage.function = function;
+  stage.depends_on = 0;
+  for (const StageId id : depends_on) {
+    // Only earlier stages, so the graph has no cycles
+    if (0 <= id && static_cast<size_t>(id) < stage_num_) {
+      stage.depends_on |= 1u << id;
+    }
+  }
+  stage.start_us = 0;
+  stage.end_us = 0;
+  return static_cast<StageId>(stage_num_++);
+}
+
+void InitSequencer::Run() {
+  done_events_ = xEventGroupCreate();
+  if (done_events_ == nullptr) {
+    ESP_LOGE(kTag, "Init sequencer event group failed, running in order");
+    for (size_t i = 0; i < stage_num_; ++i) {
+      stages_[i].start_us = esp_timer_get_time();
+      stages_[i].function();
+      stages_[i].end_us = esp_timer_get_time();
+    }
+    return;
+  }
+
+  // Workers run at the caller's priority
+  const int32_t priority = uxTaskPriorityGet(nullptr);
+  static InitStageWorker<0> worker0(this, priority);
+  static InitStageWorker<1> worker1(this, priority);
+  static InitStageWorker<2> worker2(this, priority);
+  static_assert(kWorkerNum == 3, "One worker per lane");
+  worker0.Start();
+  worker1.Start();
+  worker2.Start();
+
+  EventBits_t wait_bits = 0;
+  for (size_t i = 0; i < stage_num_; ++i) {
+    wait_bits |= 1u << i;
+  }
+  for (size_t lane = 0; lane < kWorkerNum; ++lane) {
+    wait_bits |= WorkerDoneBit(lane);
+  }
+  xEventGroupWaitBits(done_events_, wait_bits, pdFALSE, pdTRUE,
+                      portMAX_DELAY);
+}
+
+void InitSequencer::LogStageTimes() const {
+  for (size_t i = 0; i < stage_num_; ++i) {
+    const Stage& stage = stages_[i];
+    ESP_LOGI(kTag, "Init %-8s %5lld - %5lldms (%lldms)", stage.name,
+             stage.start_us / 1000, stage.end_us / 1000,
+             (stage.end_us - stage.start_us) / 1000);
+  }
+}
+
+void InitSequencer::RunStage(Stage* const stage) {
+  InitSequencer* const sequencer = stage->sequencer;
+  if (stage->depends_on != 0) {
+    xEventGroupWaitBits(sequencer->done_events_, stage->depends_on, pdFALSE,
+                        pdTRUE, portMAX_DELAY);
+  }
+  stage->start_us = esp_timer_get_time();
+  stage->function();
+  stage->end_us = esp_timer_get_time();
+
+  const size_t index = stage - sequencer->stages_;
+  xEventGroupSetBits(sequencer->done_events_, 1u << index);
+}
+
+bool InitSequencer::RunNextStage() {
+  const size_t index = next_stage_.fetch_add(1);
+  if (index >= stage_num_) {
+    return false;
+  }
+  RunStage(&stages_[index]);
+  return true;
+}
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,83 @@
+#ifndef BFOX_RECEIVER_MAIN_INIT_SEQUENCER_H_
+#define BFOX_RECEIVER_MAIN_INIT_SEQUENCER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+
+namespace bfox_receiver_system {
+
+template <int kLane>
+class InitStageWorker;
+
+/// Boot stages with dependencies.
+///
+/// Run() hands the stages to kWorkerNum worker tasks with static stacks
+/// (StaticTask). A worker takes the next stage in order and waits for the
+/// stages it depends on (event group bits), so independent peripherals
+/// initialize in parallel. Every stage is timestamped. Run once per boot.
+class InitSequencer final {
+ public:
+  static constexpr size_t kMaxStageNum = 8;
+  static constexpr size_t kWorkerNum = 3;
+  static constexpr uint32_t kStageStackDepth = 4096;  // [byte] per worker
+
+  using StageId = int;
+  using StageFunction = std::function<void()>;
+
+ public:
+  InitSequencer();
+  ~InitSequencer();
+
+  /// Register a stage running after the stages in depends_on. Returns its id,
+  /// -1 if too many stages.
+  StageId AddStage(const char* const name, const StageFunction& function,
+                   std::initializer_list<StageId> depends_on = {});
+
+  /// Run all stages and wait for them to finish (at the caller's priority)
+  void Run();
+
+  /// Log start / end of each stage [ms since boot]
+  void LogStageTimes() const;
+
+ private:
+  struct Stage {
+    InitSequencer* sequencer;
+    const char* name;
+    StageFunction function;
+    EventBits_t depends_on;
+    int64_t start_us;
+    int64_t end_us;
+  };
+
+  template <int kLane>
+  friend class InitStageWorker;
+
+  /// Bit of done_events_ set when worker lane has no stage left
+  static constexpr EventBits_t WorkerDoneBit(const int lane) {
+    return 1u << (kMaxStageNum + lane);
+  }
+
+  static void RunStage(Stage* const stage);
+
+  /// Run the next stage not taken by a worker, false if none is left
+  bool RunNextStage();
+
+ private:
+  Stage stages_[kMaxStageNum];
+  size_t stage_num_;
+  std::atomic<size_t> next_stage_;  // taken by the workers in order
+  EventGroupHandle_t done_events_;  // bit n: stage n finished
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_INIT_SEQUENCER_H_
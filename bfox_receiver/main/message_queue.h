@@ -5,76 +5,242 @@
 
 // Include ----------------------
 #include <freertos/FreeRTOS.h>
+#include <freertos/message_buffer.h>
 #include <freertos/queue.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace bfox_receiver_system {
 
+/// FreeRTOS queue: any number of senders and receivers (default)
+template <typename T>
+class QueueBackend {
+ public:
+  QueueBackend() : queue_(nullptr) {}
+
+  bool Create(const int32_t queue_size) {
+    queue_ = xQueueCreate(queue_size, sizeof(T));
+    return queue_ != nullptr;
+  }
+
+  void Destroy() {
+    xQueueReset(queue_);
+    vQueueDelete(queue_);
+    queue_ = nullptr;
+  }
+
+  bool IsCreated() const { return queue_ != nullptr; }
+
+  bool Send(const T& data, const size_t size, const TickType_t wait) {
+    return xQueueSend(queue_, &data, wait) == pdTRUE;
+  }
+
+  bool SendFromISR(const T& data, const size_t size,
+                   BaseType_t* const high_task_awoken) {
+    return xQueueSendFromISR(queue_, &data, high_task_awoken) == pdTRUE;
+  }
+
+  size_t Receive(T* const data, const TickType_t wait) {
+    return (xQueueReceive(queue_, data, wait) == pdTRUE) ? sizeof(T) : 0;
+  }
+
+ private:
+  QueueHandle_t queue_;
+};
+
+/// Direct to task notification: one pending value of up to 32 bits, no
+/// queue object. The receiving task is bound on its first receive and must
+/// not use task notifications (index 0) for anything else; sends before
+/// that fail. Depth is always 1.
+template <typename T>
+class TaskNotifyBackend {
+  static_assert(sizeof(T) <= sizeof(uint32_t) &&
+                    std::is_trivially_copyable_v<T>,
+                "Task notification carries one 32bit value");
+
+ public:
+  TaskNotifyBackend() : created_(false), receiver_(nullptr) {}
+
+  bool Create(const int32_t queue_size) {
+    created_ = true;
+    return true;
+  }
+
+  void Destroy() {
+    created_ = false;
+    receiver_ = nullptr;
+  }
+
+  bool IsCreated() const { return created_; }
+
+  bool Send(const T& data, const size_t size, const TickType_t wait) {
+    const TaskHandle_t receiver = receiver_.load();
+    return receiver != nullptr &&
+           xTaskNotify(receiver, ToValue(data), eSetValueWithoutOverwrite) ==
+               pdPASS;
+  }
+
+  bool SendFromISR(const T& data, const size_t size,
+                   BaseType_t* const high_task_awoken) {
+    const TaskHandle_t receiver = receiver_.load();
+    return receiver != nullptr &&
+           xTaskNotifyFromISR(receiver, ToValue(data),
+                              eSetValueWithoutOverwrite,
+                              high_task_awoken) == pdPASS;
+  }
+
+  size_t Receive(T* const data, const TickType_t wait) {
+    receiver_.store(xTaskGetCurrentTaskHandle());
+    uint32_t value = 0;
+    if (xTaskNotifyWait(0, UINT32_MAX, &value, wait) != pdTRUE) {
+      return 0;
+    }
+    std::memcpy(data, &value, sizeof(T));
+    return sizeof(T);
+  }
+
+ private:
+  static uint32_t ToValue(const T& data) {
+    uint32_t value = 0;
+    std::memcpy(&value, &data, sizeof(T));
+    return value;
+  }
+
+  bool created_;
+  std::atomic<TaskHandle_t> receiver_;
+};
+
+/// FreeRTOS message buffer: one sender and one receiver, records keep their
+/// length, so a T can be sent partly filled (the leading size bytes). Each
+/// record is copied in and out; FreeRTOS has no zero-copy message buffer
+/// API, the gain over a queue is storage sized by the actual records.
 template <typename T>
+class MessageBufferBackend {
+ public:
+  MessageBufferBackend() : buffer_(nullptr) {}
+
+  bool Create(const int32_t queue_size) {
+    // Each record is stored with its length
+    buffer_ = xMessageBufferCreate(queue_size * (sizeof(T) + sizeof(size_t)));
+    return buffer_ != nullptr;
+  }
+
+  void Destroy() {
+    vMessageBufferDelete(buffer_);
+    buffer_ = nullptr;
+  }
+
+  bool IsCreated() const { return buffer_ != nullptr; }
+
+  bool Send(const T& data, const size_t size, const TickType_t wait) {
+    return xMessageBufferSend(buffer_, &data, size, wait) == size;
+  }
+
+  bool SendFromISR(const T& data, const size_t size,
+                   BaseType_t* const high_task_awoken) {
+    return xMessageBufferSendFromISR(buffer_, &data, size,
+                                     high_task_awoken) == size;
+  }
+
+  size_t Receive(T* const data, const TickType_t wait) {
+    return xMessageBufferReceive(buffer_, data, sizeof(T), wait);
+  }
+
+ private:
+  MessageBufferHandle_t buffer_;
+};
+
+/// Typed message passing. The backend is chosen at compile time:
+/// QueueBackend (default), TaskNotifyBackend or MessageBufferBackend.
+template <typename T, template <typename> class Backend = QueueBackend>
 class MessageQueue {
  public:
-  MessageQueue() : queue_(nullptr) {}
+  MessageQueue() : backend_() {}
 
   virtual ~MessageQueue() { Destroy(); }
 
   bool Create(const int32_t queueSize = 1) {
-    if (queue_) {
+    if (backend_.IsCreated()) {
       return true;
     }
-    queue_ = xQueueCreate(queueSize, sizeof(T));
-    if (!queue_) {
-      return false;
-    }
-    return true;
+    return backend_.Create(queueSize);
   }
 
   void Destroy() {
-    if (queue_) {
-      xQueueReset(queue_);
-      vQueueDelete(queue_);
-      queue_ = nullptr;
+    if (backend_.IsCreated()) {
+      backend_.Destroy();
     }
   }
 
   bool ReceiveWait(T* receive_data, const int32_t max_wait_millisecond) {
-    if (!queue_) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueReceive(queue_, receive_data,
-                         pdMS_TO_TICKS(max_wait_millisecond));
+    return backend_.Receive(receive_data,
+                            pdMS_TO_TICKS(max_wait_millisecond)) != 0;
   }
 
   bool ReceiveNonBlock(T* receive_data) {
-    if (!queue_) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueReceive(queue_, receive_data, 0);
+    return backend_.Receive(receive_data, 0) != 0;
   }
 
   bool ReceiveBlock(T* receive_data) {
-    if (!queue_) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueReceive(queue_, receive_data, portMAX_DELAY);
+    return backend_.Receive(receive_data, portMAX_DELAY) != 0;
+  }
+
+  /// Received length [byte] (MessageBufferBackend), 0 on timeout
+  size_t ReceiveRecord(T* receive_data, const int32_t max_wait_millisecond) {
+    if (!backend_.IsCreated()) {
+      return 0;
+    }
+    return backend_.Receive(receive_data,
+                            pdMS_TO_TICKS(max_wait_millisecond));
   }
 
   bool Send(const T& data) {
-    if (!queue_) {
+    if (!backend_.IsCreated()) {
       return false;
     }
-    return xQueueSend(queue_, &data, 0) == pdTRUE;
+    return backend_.Send(data, sizeof(T), 0);
   }
 
-  bool SendFromISR(const T& data) {
-    if (!queue_) {
+  /// Send from an ISR. If a higher priority task was woken the ISR yields
+  /// on exit; pass high_task_awoken to yield yourself instead (e.g. by
+  /// returning it from a driver callback). Returns true if sent.
+  bool SendFromISR(const T& data,
+                   BaseType_t* const high_task_awoken = nullptr) {
+    return SendRecordFromISR(data, sizeof(T), high_task_awoken);
+  }
+
+  /// SendFromISR of the leading size bytes of data (MessageBufferBackend);
+  /// the other backends send the whole T
+  bool SendRecordFromISR(const T& data, const size_t size,
+                         BaseType_t* const high_task_awoken = nullptr) {
+    if (!backend_.IsCreated() || size > sizeof(T)) {
       return false;
     }
-    BaseType_t high_task_awoken = pdFALSE;
-    xQueueSendFromISR(queue_, &data, &high_task_awoken);
-    return (high_task_awoken == pdTRUE);
+    BaseType_t awoken = pdFALSE;
+    const bool sent = backend_.SendFromISR(data, size, &awoken);
+    if (high_task_awoken != nullptr) {
+      *high_task_awoken |= awoken;
+    } else {
+      portYIELD_FROM_ISR(awoken);
+    }
+    return sent;
   }
 
  private:
-  QueueHandle_t queue_;
+  Backend<T> backend_;
 };
 
 }  // namespace bfox_receiver_system
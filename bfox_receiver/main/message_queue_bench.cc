@@ -0,0 +1,128 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "message_queue_bench.h"
+
+#include <esp_timer.h>
+
+#include "logger.h"
+
+namespace bfox_receiver_system {
+
+static perf::Histogram queue_isr_histogram("mq.queue_isr_us");
+static perf::Histogram notify_isr_histogram("mq.notify_isr_us");
+static perf::Histogram buffer_isr_histogram("mq.buffer_isr_us");
+
+MessageQueueBench::MessageQueueBench()
+    : StaticTask(kTaskName, kPriority, kCoreId),
+      queue_(),
+      notify_(),
+      buffer_(),
+      gptimer_(),
+      phase_(Phase::kQueue),
+      send_count_(0),
+      failed_count_(0),
+      sample_count_(0) {}
+
+MessageQueueBench::~MessageQueueBench() { gptimer_.Destroy(); }
+
+void MessageQueueBench::Initialize() {
+  // A few in flight, a late receive is measured rather than lost
+  constexpr int32_t kQueueSize = 4;
+  if (!queue_.Create(kQueueSize) || !notify_.Create() ||
+      !buffer_.Create(kQueueSize)) {
+    ESP_LOGE(kTag, "Creating queues failed");
+    Stop();
+    return;
+  }
+  constexpr uint32_t kTimerResolution = 1000000u;  // 1us
+  gptimer_.Create(kTimerResolution, &MessageQueueBench::TimerCallback, this);
+  gptimer_.Start(kSendIntervalUs);
+}
+
+void MessageQueueBench::Update() {
+  constexpr int32_t kReceiveLimitMs = 100;
+  uint32_t sent_us = 0;
+  switch (phase_.load()) {
+    case Phase::kQueue:
+      if (queue_.ReceiveWait(&sent_us, kReceiveLimitMs)) {
+        RecordLatency(&queue_isr_histogram, sent_us);
+      }
+      break;
+    case Phase::kNotify:
+      if (notify_.ReceiveWait(&sent_us, kReceiveLimitMs)) {
+        RecordLatency(&notify_isr_histogram, sent_us);
+      }
+      break;
+    case Phase::kBuffer: {
+      BufferRecord record;
+      if (buffer_.ReceiveRecord(&record, kReceiveLimitMs) >=
+          sizeof(record.sent_us)) {
+        RecordLatency(&buffer_isr_histogram, record.sent_us);
+      }
+      break;
+    }
+    case Phase::kDone:
+    default:
+      gptimer_.Stop();
+      ESP_LOGI(kTag, "MessageQueue bench done, see perf mq.*");
+      Stop();
+      break;
+  }
+}
+
+void MessageQueueBench::RecordLatency(perf::Histogram* const histogram,
+                                      const uint32_t sent_us) {
+  histogram->Record(static_cast<uint32_t>(esp_timer_get_time()) - sent_us);
+  if (++sample_count_ == kSampleNum) {
+    NextPhase();
+  }
+}
+
+void MessageQueueBench::NextPhase() {
+  static constexpr const char* kPhaseNames[] = {"queue", "notify", "buffer"};
+  const Phase phase = phase_.load();
+  ESP_LOGI(kTag, "MessageQueue bench %s: samples:%lu failed:%lu",
+           kPhaseNames[static_cast<int32_t>(phase)], sample_count_,
+           failed_count_.exchange(0));
+  sample_count_ = 0;
+  phase_.store(static_cast<Phase>(static_cast<int32_t>(phase) + 1));
+}
+
+bool MessageQueueBench::TimerCallback(
+    gptimer_handle_t timer, const gptimer_alarm_event_data_t* event_data,
+    void* arg) {
+  MessageQueueBench* const self = static_cast<MessageQueueBench*>(arg);
+  const uint32_t now_us = static_cast<uint32_t>(esp_timer_get_time());
+  // The driver yields on the returned flag
+  BaseType_t high_task_awoken = pdFALSE;
+  bool sent = true;
+  switch (self->phase_.load()) {
+    case Phase::kQueue:
+      sent = self->queue_.SendFromISR(now_us, &high_task_awoken);
+      break;
+    case Phase::kNotify:
+      sent = self->notify_.SendFromISR(now_us, &high_task_awoken);
+      break;
+    case Phase::kBuffer: {
+      // The time stamp and 0 - 28 payload bytes
+      const size_t payload_size =
+          self->send_count_ % (sizeof(BufferRecord::payload) + 1);
+      const BufferRecord record = {.sent_us = now_us, .payload = {}};
+      sent = self->buffer_.SendRecordFromISR(
+          record, sizeof(record.sent_us) + payload_size, &high_task_awoken);
+      break;
+    }
+    case Phase::kDone:
+    default:
+      break;
+  }
+  ++self->send_count_;
+  if (!sent) {
+    ++self->failed_count_;
+  }
+  return high_task_awoken == pdTRUE;
+}
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,80 @@
+#ifndef BFOX_RECEIVER_MAIN_MESSAGE_QUEUE_BENCH_H_
+#define BFOX_RECEIVER_MAIN_MESSAGE_QUEUE_BENCH_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "gptimer.h"
+#include "message_queue.h"
+#include "perf_counters.h"
+#include "task.h"
+
+namespace bfox_receiver_system {
+
+/// ISR to task latency of each MessageQueue backend (development).
+///
+/// A GPTimer alarm sends its esp_timer time from the ISR, this task
+/// receives it and records the difference into the perf histograms
+/// "mq.queue_isr_us", "mq.notify_isr_us" and "mq.buffer_isr_us". The
+/// backends run one after another, kSampleNum sends each; the message
+/// buffer sends records of varying length. The task stops when done, the
+/// figures stay in perf::Dump.
+class MessageQueueBench final : public StaticTask<MessageQueueBench> {
+ public:
+  static constexpr const char* kTaskName = "MessageQueueBench";
+  static constexpr int kPriority = Task::kPriorityHigh;
+  static constexpr int kCoreId = tskNO_AFFINITY;
+  static constexpr uint32_t kStackDepth = 3072;  // [byte]
+
+  static constexpr uint32_t kSampleNum = 1000;    // per backend
+  static constexpr uint64_t kSendIntervalUs = 2000;
+
+ public:
+  MessageQueueBench();
+  ~MessageQueueBench();
+
+  void Initialize() override;
+  void Update() override;
+
+ private:
+  enum class Phase : int32_t {
+    kQueue,
+    kNotify,
+    kBuffer,
+    kDone,
+  };
+
+  /// Message buffer record, sent partly filled
+  struct BufferRecord {
+    uint32_t sent_us;
+    uint8_t payload[28];
+  };
+
+  static bool TimerCallback(gptimer_handle_t timer,
+                            const gptimer_alarm_event_data_t* event_data,
+                            void* arg);
+
+  void RecordLatency(perf::Histogram* const histogram,
+                     const uint32_t sent_us);
+  void NextPhase();
+
+ private:
+  MessageQueue<uint32_t> queue_;
+  MessageQueue<uint32_t, TaskNotifyBackend> notify_;
+  MessageQueue<BufferRecord, MessageBufferBackend> buffer_;
+  GPTimer gptimer_;
+  std::atomic<Phase> phase_;
+  uint32_t send_count_;  // ISR only, varies the record length
+  std::atomic<uint32_t> failed_count_;  // sends that found no room
+  uint32_t sample_count_;  // in the current phase
+};
+
+using MessageQueueBenchUniquePtr = std::unique_ptr<MessageQueueBench>;
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_MESSAGE_QUEUE_BENCH_H_
@@ -0,0 +1,196 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "perf_counters.h"
+
+#include <esp_console.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "logger.h"
+
+namespace bfox_receiver_system {
+namespace perf {
+
+namespace {
+
+// Constant initialized, so registration from any static constructor is safe
+Counter* first_counter = nullptr;
+Histogram* first_histogram = nullptr;
+
+int64_t dumped_time_us = 0;  // previous Dump
+
+size_t GetBucketIndex(const uint32_t value_us) {
+  if (value_us == 0) {
+    return 0;
+  }
+  const size_t bucket = 32 - __builtin_clz(value_us);
+  return (bucket < Histogram::kBucketNum) ? bucket
+                                          : Histogram::kBucketNum - 1;
+}
+
+int PerfCommand(int argc, char** argv) {
+  Dump();
+  return 0;
+}
+
+}  // namespace
+
+Counter::Counter(const char* const name)
+    : name_(name), value_(0), dumped_value_(0), next_(first_counter) {
+  first_counter = this;
+}
+
+Histogram::Histogram(const char* const name)
+    : name_(name),
+      count_(0),
+      sum_(0),
+      max_(0),
+      buckets_(),
+      next_(first_histogram) {
+  first_histogram = this;
+}
+
+void Histogram::Record(const uint32_t value_us) {
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value_us, std::memory_order_relaxed);
+  buckets_[GetBucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+  uint32_t max = max_.load(std::memory_order_relaxed);
+  while (value_us > max &&
+         !max_.compare_exchange_weak(max, value_us,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+uint32_t Histogram::GetMean() const {
+  const uint32_t count = GetCount();
+  return (count == 0) ? 0 : sum_.load(std::memory_order_relaxed) / count;
+}
+
+uint32_t Histogram::GetPercentileBound(const uint32_t per_mille) const {
+  const uint64_t target =
+      (static_cast<uint64_t>(GetCount()) * per_mille + 999) / 1000;
+  uint64_t cumulative = 0;
+  for (size_t bucket = 0; bucket + 1 < kBucketNum; ++bucket) {
+    cumulative += GetBucket(bucket);
+    if (cumulative >= target) {
+      return (bucket == 0) ? 0 : std::min((1u << bucket) - 1, GetMax());
+    }
+  }
+  return GetMax();
+}
+
+const Counter* GetFirstCounter() { return first_counter; }
+
+const Histogram* GetFirstHistogram() { return first_histogram; }
+
+void Dump() {
+  const int64_t now_us = esp_timer_get_time();
+  const int64_t elapsed_ms = (now_us - dumped_time_us) / 1000;
+  dumped_time_us = now_us;
+
+  printf("Uptime %" PRId64 "ms, rates over the last %" PRId64 "ms\n",
+         now_us / 1000, elapsed_ms);
+  for (Counter* counter = first_counter; counter != nullptr;
+       counter = counter->next_) {
+    const uint32_t value = counter->Get();
+    const uint32_t rate_x10 =
+        (elapsed_ms > 0)
+            ? static_cast<uint32_t>(
+                  static_cast<int64_t>(value - counter->dumped_value_) *
+                  10000 / elapsed_ms)
+            : 0;
+    counter->dumped_value_ = value;
+    printf("%-24s %10" PRIu32 " %6" PRIu32 ".%" PRIu32 "/s\n",
+           counter->GetName(), value, rate_x10 / 10, rate_x10 % 10);
+  }
+  for (const Histogram* histogram = first_histogram; histogram != nullptr;
+       histogram = histogram->GetNext()) {
+    printf("%-24s n:%" PRIu32 " avg:%" PRIu32 "us p50<=%" PRIu32
+           "us p99<=%" PRIu32 "us max:%" PRIu32 "us\n",
+           histogram->GetName(), histogram->GetCount(), histogram->GetMean(),
+           histogram->GetPercentileBound(500),
+           histogram->GetPercentileBound(990), histogram->GetMax());
+  }
+}
+
+size_t Format(char* const buffer, const size_t size) {
+  size_t length = 0;
+  auto append = [buffer, size, &length](const int written) {
+    if (written < 0 || length + written >= size) {
+      return false;  // line left out
+    }
+    length += written;
+    return true;
+  };
+
+  for (const Counter* counter = first_counter; counter != nullptr;
+       counter = counter->GetNext()) {
+    if (!append(snprintf(buffer + length, size - length, "%s %" PRIu32 "\n",
+                         counter->GetName(), counter->Get()))) {
+      break;
+    }
+  }
+  for (const Histogram* histogram = first_histogram; histogram != nullptr;
+       histogram = histogram->GetNext()) {
+    if (!append(snprintf(buffer + length, size - length,
+                         "%s n=%" PRIu32 " avg=%" PRIu32 " p99=%" PRIu32
+                         " max=%" PRIu32 "\n",
+                         histogram->GetName(), histogram->GetCount(),
+                         histogram->GetMean(),
+                         histogram->GetPercentileBound(990),
+                         histogram->GetMax()))) {
+      break;
+    }
+  }
+  if (length < size) {
+    buffer[length] = '\0';
+  }
+  return length;
+}
+
+bool StartConsole() {
+  esp_console_repl_t* repl = nullptr;
+  // Unused when sdkconfig has no console device
+  [[maybe_unused]] esp_console_repl_config_t repl_config =
+      ESP_CONSOLE_REPL_CONFIG_DEFAULT();
+  repl_config.prompt = "bfox>";
+
+  esp_err_t ret = ESP_FAIL;
+#if defined(CONFIG_ESP_CONSOLE_UART_DEFAULT) || \
+    defined(CONFIG_ESP_CONSOLE_UART_CUSTOM)
+  const esp_console_dev_uart_config_t uart_config =
+      ESP_CONSOLE_DEV_UART_CONFIG_DEFAULT();
+  ret = esp_console_new_repl_uart(&uart_config, &repl_config, &repl);
+#elif defined(CONFIG_ESP_CONSOLE_USB_SERIAL_JTAG)
+  const esp_console_dev_usb_serial_jtag_config_t usb_config =
+      ESP_CONSOLE_DEV_USB_SERIAL_JTAG_CONFIG_DEFAULT();
+  ret = esp_console_new_repl_usb_serial_jtag(&usb_config, &repl_config, &repl);
+#endif
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "Console not started: %s", esp_err_to_name(ret));
+    return false;
+  }
+
+  const esp_console_cmd_t perf_command = {
+      .command = "perf",
+      .help = "Print performance counters and histograms",
+      .hint = nullptr,
+      .func = &PerfCommand,
+  };
+  ret = esp_console_cmd_register(&perf_command);
+  if (ret == ESP_OK) {
+    ret = esp_console_start_repl(repl);
+  }
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "Console command failed: %s", esp_err_to_name(ret));
+    return false;
+  }
+  return true;
+}
+
+}  // namespace perf
+}  // namespace bfox_receiver_system
@@ -0,0 +1,132 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "power_manager.h"
+
+#include <esp_pm.h>
+#include <sdkconfig.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "logger.h"
+
+namespace bfox_receiver_system {
+
+namespace {
+
+// Names used by esp_pm_dump_locks(), in Mode order
+constexpr const char* kModeNames[PowerManager::kModeNum] = {
+    "SLEEP", "APB_MIN", "APB_MAX", "CPU_MAX"};
+
+}  // namespace
+
+PowerManager::PowerManager() : last_mode_time_us_(), last_radio_on_ms_(0) {}
+
+bool PowerManager::Configure() {
+#if CONFIG_PM_ENABLE
+  const esp_pm_config_t pm_config = {
+      .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+      .min_freq_mhz = kMinFreqMhz,
+      .light_sleep_enable = true,
+  };
+  const esp_err_t ret = esp_pm_configure(&pm_config);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "Power management config failed: %s",
+             esp_err_to_name(ret));
+    return false;
+  }
+  GetModeTimes(last_mode_time_us_);
+  ESP_LOGI(kTag, "Light sleep enabled. %lu-%dMHz", kMinFreqMhz,
+           CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ);
+  return true;
+#else
+  ESP_LOGW(kTag, "Power management disabled (CONFIG_PM_ENABLE)");
+  return false;
+#endif
+}
+
+void PowerManager::LogCurrentEstimate(const int64_t radio_on_ms) {
+  int64_t mode_time_us[kModeNum] = {};
+  if (!GetModeTimes(mode_time_us)) {
+    return;
+  }
+
+  int64_t total_us = 0;
+  int64_t delta_us[kModeNum] = {};
+  for (size_t mode = 0; mode < kModeNum; ++mode) {
+    delta_us[mode] = mode_time_us[mode] - last_mode_time_us_[mode];
+    last_mode_time_us_[mode] = mode_time_us[mode];
+    total_us += delta_us[mode];
+  }
+  const int64_t radio_delta_ms = radio_on_ms - last_radio_on_ms_;
+  last_radio_on_ms_ = radio_on_ms;
+  if (total_us <= 0) {
+    return;
+  }
+
+  // Time weighted average of the per mode currents
+  int64_t charge = 0;  // [uA * us]
+  for (size_t mode = 0; mode < kModeNum; ++mode) {
+    const int64_t mode_charge = delta_us[mode] * kModeCurrentUa[mode];
+    charge += mode_charge;
+    ESP_LOGI(kTag, "PM %-7s %3" PRId64 "%% %5" PRId64 "ua", kModeNames[mode],
+             delta_us[mode] * 100 / total_us, mode_charge / total_us);
+  }
+  const int64_t radio_charge = radio_delta_ms * 1000 * kRadioRxCurrentUa;
+  charge += radio_charge;
+  ESP_LOGI(kTag, "PM radio   %3" PRId64 "%% %5" PRId64 "ua",
+           radio_delta_ms * 1000 * 100 / total_us, radio_charge / total_us);
+  ESP_LOGI(kTag, "PM average %" PRId64 ".%03" PRId64 "mA over %" PRId64 "s",
+           charge / total_us / 1000, charge / total_us % 1000,
+           total_us / 1000000);
+
+  // Some lock was held the whole time, show which
+  if (delta_us[kModeSleep] == 0) {
+    ESP_LOGW(kTag, "PM no light sleep, locks:");
+    esp_pm_dump_locks(stdout);
+  }
+}
+
+bool PowerManager::GetModeTimes(int64_t mode_time_us[kModeNum]) {
+#if CONFIG_PM_ENABLE && CONFIG_PM_PROFILING
+  // Mode times are only exposed through the text dump
+  char* buffer = nullptr;
+  size_t size = 0;
+  FILE* const stream = open_memstream(&buffer, &size);
+  if (stream == nullptr) {
+    return false;
+  }
+  esp_pm_dump_locks(stream);
+  std::fclose(stream);
+
+  // "<mode>  <freq>M  <time us>  <percent>%" after "Mode stats:"
+  size_t found = 0;
+  const char* line = std::strstr(buffer, "Mode stats:");
+  while (line != nullptr && *line != '\0') {
+    char name[16] = {};
+    long long time_us = 0;
+    if (std::sscanf(line, "%15s %*uM %lld", name, &time_us) == 2) {
+      for (size_t mode = 0; mode < kModeNum; ++mode) {
+        if (std::strcmp(name, kModeNames[mode]) == 0) {
+          mode_time_us[mode] = time_us;
+          ++found;
+        }
+      }
+    }
+    line = std::strchr(line, '\n');
+    if (line != nullptr) {
+      ++line;
+    }
+  }
+  std::free(buffer);
+  return found == kModeNum;
+#else
+  return false;
+#endif
+}
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,56 @@
+#ifndef BFOX_RECEIVER_MAIN_POWER_MANAGER_H_
+#define BFOX_RECEIVER_MAIN_POWER_MANAGER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Automatic light sleep (esp_pm + tickless idle) and an average current
+/// estimate from the time spent in each power management mode.
+///
+/// Mode times need CONFIG_PM_PROFILING; the currents are typical ESP32-C6
+/// datasheet figures, to be calibrated against a measurement.
+class PowerManager final {
+ public:
+  static constexpr uint32_t kMinFreqMhz = 40;  // XTAL
+
+  enum Mode : size_t {
+    kModeSleep,   // light sleep
+    kModeApbMin,  // idle, lowest frequency
+    kModeApbMax,
+    kModeCpuMax,
+    kModeNum,
+  };
+
+  /// Typical supply current per mode [uA]
+  static constexpr uint32_t kModeCurrentUa[kModeNum] = {180, 13000, 22000,
+                                                        32000};
+  /// Added while the radio receives (scan window) [uA]
+  static constexpr uint32_t kRadioRxCurrentUa = 38000;
+
+ public:
+  PowerManager();
+
+  /// Enable frequency scaling and automatic light sleep
+  bool Configure();
+
+  /// Log time share and estimated current of each mode since the last call.
+  /// radio_on_ms: accumulated scan window time.
+  void LogCurrentEstimate(const int64_t radio_on_ms);
+
+ private:
+  /// Accumulated time per mode [us], false without CONFIG_PM_PROFILING
+  static bool GetModeTimes(int64_t mode_time_us[kModeNum]);
+
+ private:
+  int64_t last_mode_time_us_[kModeNum];
+  int64_t last_radio_on_ms_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_POWER_MANAGER_H_
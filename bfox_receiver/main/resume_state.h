@@ -0,0 +1,48 @@
+#ifndef BFOX_RECEIVER_MAIN_RESUME_STATE_H_
+#define BFOX_RECEIVER_MAIN_RESUME_STATE_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "beacon_tracker.h"
+#include "ble_beacon_item.h"
+#include "rssi_filter.h"
+
+namespace bfox_receiver_system {
+
+/// Beacon entry kept over deep sleep (trend samples are not, their
+/// timestamps do not survive the sleep). Plain data only, see ResumeState.
+struct ResumeItem {
+  uint16_t minor;
+  int8_t measured_power;
+  int32_t rssi;
+  uint32_t distance_cm;
+  RssiFilter::Snapshot rssi_filter;
+};
+
+/// State kept in RTC memory over deep sleep, so a wake resumes the search
+/// screen without the cold boot path
+struct ResumeState {
+  static constexpr uint32_t kMagic = 0x42465253;  // "BFRS"
+  static constexpr size_t kMaxItemNum =
+      BeaconTracker::BeaconItemTable::kMaxItems;
+
+  uint32_t magic;  // kMagic when valid
+  uint16_t major;
+  bool lcd_initialized;  // LCD stayed powered and was cleared
+  uint8_t item_count;
+  ResumeItem items[kMaxItemNum];  // active group
+};
+
+// A constructor would make the RTC_DATA_ATTR instance dynamically
+// initialized, rewriting the saved state on every boot including a wake
+static_assert(std::is_trivially_default_constructible_v<ResumeState>,
+              "ResumeState must survive deep sleep untouched");
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_RESUME_STATE_H_
@@ -0,0 +1,169 @@
+#ifndef BFOX_RECEIVER_MAIN_RSSI_FILTER_H_
+#define BFOX_RECEIVER_MAIN_RSSI_FILTER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+enum class RssiFilterMode : uint8_t {
+  kRaw,     // last received value
+  kEma,     // exponential moving average
+  kKalman,  // 1-D Kalman filter (constant RSSI model)
+  kMedian,  // sliding median
+};
+
+/// Per-beacon RSSI smoothing. Integer (fixed-point) only, the ESP32-C6 has no
+/// FPU. State for one mode at a time; changing mode restarts the filter.
+class RssiFilter {
+ public:
+  static constexpr int32_t kEmaShift = 2;  // alpha = 1/4
+  static constexpr int32_t kKalmanProcessNoise = 128;       // Q8: 0.5 dB^2
+  static constexpr int32_t kKalmanMeasurementNoise = 4096;  // Q8: 16 dB^2
+  static constexpr size_t kMedianWindow = 5;
+
+ private:
+  static constexpr int32_t kFixedShift = 8;  // Q8 fixed point
+
+  struct EmaState {
+    int32_t value;  // Q8 dBm
+  };
+
+  struct KalmanState {
+    int32_t estimate;  // Q8 dBm
+    int32_t error;     // Q8 dB^2 (estimate covariance)
+  };
+
+  struct MedianState {
+    int8_t samples[kMedianWindow];
+    uint8_t count;
+    uint8_t index;
+  };
+
+  union State {
+    EmaState ema;
+    KalmanState kalman;
+    MedianState median;
+  };
+
+ public:
+  /// Filter state as plain data: trivially constructible, so it can live
+  /// in memory that a boot must not initialize (RTC_DATA_ATTR)
+  struct Snapshot {
+    RssiFilterMode mode;
+    uint8_t sample_count;
+    State state;
+  };
+
+ public:
+  RssiFilter() : mode_(RssiFilterMode::kRaw), sample_count_(0), state_() {}
+
+  void Reset() { sample_count_ = 0; }
+
+  Snapshot Save() const {
+    return {.mode = mode_, .sample_count = sample_count_, .state = state_};
+  }
+
+  void Restore(const Snapshot& snapshot) {
+    mode_ = snapshot.mode;
+    sample_count_ = snapshot.sample_count;
+    state_ = snapshot.state;
+  }
+
+  /// Add sample and return filtered RSSI [dBm]
+  int32_t Apply(const RssiFilterMode mode, const int32_t rssi) {
+    if (mode != mode_) {
+      mode_ = mode;
+      sample_count_ = 0;
+    }
+    const bool first = (sample_count_ == 0);
+    if (sample_count_ < UINT8_MAX) {
+      ++sample_count_;
+    }
+
+    switch (mode_) {
+      case RssiFilterMode::kEma:
+        return ApplyEma(rssi, first);
+      case RssiFilterMode::kKalman:
+        return ApplyKalman(rssi, first);
+      case RssiFilterMode::kMedian:
+        return ApplyMedian(rssi, first);
+      case RssiFilterMode::kRaw:
+      default:
+        return rssi;
+    }
+  }
+
+  uint8_t GetSampleCount() const { return sample_count_; }
+
+ private:
+  int32_t ApplyEma(const int32_t rssi, const bool first) {
+    const int32_t sample = rssi * (1 << kFixedShift);
+    if (first) {
+      state_.ema.value = sample;
+    } else {
+      state_.ema.value += (sample - state_.ema.value) / (1 << kEmaShift);
+    }
+    return Round(state_.ema.value);
+  }
+
+  int32_t ApplyKalman(const int32_t rssi, const bool first) {
+    const int32_t measurement = rssi * (1 << kFixedShift);
+    if (first) {
+      state_.kalman.estimate = measurement;
+      state_.kalman.error = kKalmanMeasurementNoise;
+      return rssi;
+    }
+    // Predict
+    const int32_t error = state_.kalman.error + kKalmanProcessNoise;
+    // Update (gain in Q15)
+    const int32_t gain = static_cast<int32_t>(
+        (static_cast<int64_t>(error) << 15) / (error + kKalmanMeasurementNoise));
+    state_.kalman.estimate += static_cast<int32_t>(
+        (static_cast<int64_t>(gain) * (measurement - state_.kalman.estimate)) >>
+        15);
+    state_.kalman.error = static_cast<int32_t>(
+        (static_cast<int64_t>((1 << 15) - gain) * error) >> 15);
+    return Round(state_.kalman.estimate);
+  }
+
+  int32_t ApplyMedian(const int32_t rssi, const bool first) {
+    MedianState& median = state_.median;
+    if (first) {
+      median.count = 0;
+      median.index = 0;
+    }
+    median.samples[median.index] = static_cast<int8_t>(rssi);
+    median.index = (median.index + 1) % kMedianWindow;
+    if (median.count < kMedianWindow) {
+      ++median.count;
+    }
+
+    // Insertion sort of the (small) window
+    int8_t sorted[kMedianWindow];
+    for (size_t i = 0; i < median.count; ++i) {
+      size_t j = i;
+      for (; 0 < j && median.samples[i] < sorted[j - 1]; --j) {
+        sorted[j] = sorted[j - 1];
+      }
+      sorted[j] = median.samples[i];
+    }
+    return sorted[median.count / 2];
+  }
+
+  static int32_t Round(const int32_t fixed_value) {
+    return (fixed_value + (1 << (kFixedShift - 1))) >> kFixedShift;
+  }
+
+ private:
+  RssiFilterMode mode_;
+  uint8_t sample_count_;
+  State state_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_RSSI_FILTER_H_
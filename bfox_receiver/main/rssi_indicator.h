@@ -0,0 +1,81 @@
+#ifndef BFOX_RECEIVER_MAIN_RSSI_INDICATOR_H_
+#define BFOX_RECEIVER_MAIN_RSSI_INDICATOR_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+#include <algorithm>
+#include <cstdint>
+
+#include "rssi_trend.h"
+
+namespace bfox_receiver_system {
+
+namespace rssi_indicator {
+
+/// Signal bar on the LCD: kCellNum cells of kLevelsPerCell pixel columns
+constexpr int kCellNum = 6;
+constexpr int kLevelsPerCell = 5;
+constexpr int kLevelNum = kCellNum * kLevelsPerCell;
+
+/// RSSI range mapped linearly onto the bar (2dB per level)
+constexpr int32_t kMinRssi = -100;
+constexpr int32_t kMaxRssi = -40;
+
+/// CGRAM code of a cell with n columns filled is kGlyphCodeBase + n - 1.
+/// Code 0 is avoided since it terminates strings.
+constexpr uint8_t kGlyphCodeBase = 1;
+constexpr uint8_t kGlyphNum = kLevelsPerCell;
+
+/// Lit columns for the RSSI [dBm], at least one for a received beacon
+inline int GetLevel(const int32_t rssi) {
+  const int32_t level =
+      (rssi - kMinRssi) * kLevelNum / (kMaxRssi - kMinRssi);
+  return std::clamp<int32_t>(level, 1, kLevelNum);
+}
+
+/// 5x8 pattern of a cell with fill (1 - kLevelsPerCell) columns lit
+inline void MakeGlyph(const int fill, uint8_t pattern[8]) {
+  const uint8_t row = static_cast<uint8_t>((0x1F << (kLevelsPerCell - fill)) &
+                                           0x1F);
+  for (int i = 0; i < 7; ++i) {
+    pattern[i] = row;
+  }
+  pattern[7] = 0x00;  // keep the cursor line blank
+}
+
+/// Character codes of the bar cells for the level
+inline void Render(const int level, uint8_t cells[kCellNum]) {
+  for (int cell = 0; cell < kCellNum; ++cell) {
+    const int fill =
+        std::clamp(level - cell * kLevelsPerCell, 0, kLevelsPerCell);
+    cells[cell] = (fill == 0) ? ' ' : kGlyphCodeBase + fill - 1;
+  }
+}
+
+/// Trend arrows follow the bar glyphs
+constexpr uint8_t kApproachingCode = kGlyphCodeBase + kGlyphNum;
+constexpr uint8_t kRecedingCode = kApproachingCode + 1;
+static_assert(kRecedingCode < 8, "CGRAM holds 8 glyphs");
+
+constexpr uint8_t kApproachingGlyph[8] = {0x04, 0x0E, 0x15, 0x04,
+                                          0x04, 0x04, 0x04, 0x00};
+constexpr uint8_t kRecedingGlyph[8] = {0x04, 0x04, 0x04, 0x04,
+                                       0x15, 0x0E, 0x04, 0x00};
+
+/// Separator between minor and bar: an arrow once the trend is confident
+inline uint8_t RenderTrend(const RssiTrend::Direction trend) {
+  switch (trend) {
+    case RssiTrend::Direction::kApproaching:
+      return kApproachingCode;
+    case RssiTrend::Direction::kReceding:
+      return kRecedingCode;
+    default:
+      return '|';
+  }
+}
+
+}  // namespace rssi_indicator
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_RSSI_INDICATOR_H_
@@ -0,0 +1,144 @@
+#ifndef BFOX_RECEIVER_MAIN_RSSI_TREND_H_
+#define BFOX_RECEIVER_MAIN_RSSI_TREND_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <cstddef>
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// RSSI trend of one beacon: least-squares slope over a sliding window of
+/// (time, RSSI) samples. Running sums make each sample O(1) (amortized over
+/// evictions), integer only.
+class RssiTrend {
+ public:
+  enum class Direction : int8_t {
+    kUnknown,  // not enough samples in the window
+    kSteady,
+    kApproaching,  // RSSI rising
+    kReceding,     // RSSI falling
+  };
+
+  static constexpr size_t kWindowSize = 12;   // samples
+  static constexpr int64_t kWindowMs = 8000;  // older samples are evicted
+  // Confidence gate
+  static constexpr size_t kMinSamples = 5;
+  static constexpr int32_t kMinSpanMs = 2000;
+  static constexpr int32_t kSlopeThresholdX10 = 10;  // 1.0 dB/s
+
+ private:
+  // Offsets stay below kRebaseMs + kWindowMs, within uint16_t
+  static constexpr int32_t kRebaseMs = 30000;
+
+ public:
+  RssiTrend()
+      : base_ms_(0),
+        offsets_ms_(),
+        rssi_(),
+        head_(0),
+        count_(0),
+        sum_t_(0),
+        sum_r_(0),
+        sum_tt_(0),
+        sum_tr_(0) {}
+
+  /// Add a sample and return the trend
+  Direction Add(const int64_t now_ms, const int32_t rssi) {
+    // Evict samples out of the window, or the oldest when full
+    while (count_ != 0 &&
+           (count_ == kWindowSize ||
+            now_ms - (base_ms_ + offsets_ms_[Tail()]) > kWindowMs)) {
+      Remove(Tail());
+    }
+    if (count_ == 0 || now_ms - base_ms_ > kRebaseMs) {
+      Rebase(now_ms);
+    }
+
+    const int32_t t = static_cast<int32_t>(now_ms - base_ms_);
+    offsets_ms_[head_] = static_cast<uint16_t>(t);
+    rssi_[head_] = static_cast<int8_t>(rssi);
+    head_ = (head_ + 1) % kWindowSize;
+    ++count_;
+    sum_t_ += t;
+    sum_r_ += rssi;
+    sum_tt_ += static_cast<int64_t>(t) * t;
+    sum_tr_ += t * rssi;
+
+    return GetDirection();
+  }
+
+  /// Slope [0.1 dB/s], valid when GetDirection() != kUnknown
+  int32_t GetSlopeX10() const {
+    const int64_t n = count_;
+    const int64_t denominator =
+        n * sum_tt_ - static_cast<int64_t>(sum_t_) * sum_t_;
+    if (denominator <= 0) {
+      return 0;
+    }
+    const int64_t numerator =
+        n * sum_tr_ - static_cast<int64_t>(sum_t_) * sum_r_;
+    return static_cast<int32_t>(numerator * 10000 / denominator);  // per ms
+  }
+
+  Direction GetDirection() const {
+    if (count_ < kMinSamples ||
+        offsets_ms_[Newest()] - offsets_ms_[Tail()] < kMinSpanMs) {
+      return Direction::kUnknown;
+    }
+    const int32_t slope_x10 = GetSlopeX10();
+    if (slope_x10 >= kSlopeThresholdX10) {
+      return Direction::kApproaching;
+    }
+    if (slope_x10 <= -kSlopeThresholdX10) {
+      return Direction::kReceding;
+    }
+    return Direction::kSteady;
+  }
+
+ private:
+  size_t Tail() const { return (head_ + kWindowSize - count_) % kWindowSize; }
+  size_t Newest() const { return (head_ + kWindowSize - 1) % kWindowSize; }
+
+  void Remove(const size_t index) {
+    const int32_t t = offsets_ms_[index];
+    const int32_t r = rssi_[index];
+    --count_;
+    sum_t_ -= t;
+    sum_r_ -= r;
+    sum_tt_ -= static_cast<int64_t>(t) * t;
+    sum_tr_ -= t * r;
+  }
+
+  /// Move the time origin to the oldest sample (or now) and shift the sums
+  void Rebase(const int64_t now_ms) {
+    const int64_t new_base_ms =
+        (count_ != 0) ? base_ms_ + offsets_ms_[Tail()] : now_ms;
+    const int32_t d = static_cast<int32_t>(new_base_ms - base_ms_);
+    for (size_t i = 0; i < count_; ++i) {
+      offsets_ms_[(Tail() + i) % kWindowSize] -= d;
+    }
+    sum_tt_ += -2 * static_cast<int64_t>(d) * sum_t_ +
+               static_cast<int64_t>(count_) * d * d;
+    sum_tr_ -= d * sum_r_;
+    sum_t_ -= static_cast<int32_t>(count_) * d;
+    base_ms_ = new_base_ms;
+  }
+
+ private:
+  int64_t base_ms_;
+  uint16_t offsets_ms_[kWindowSize];  // sample time - base_ms_
+  int8_t rssi_[kWindowSize];
+  uint8_t head_;
+  uint8_t count_;
+  // Running sums over the window (t relative to base_ms_)
+  int32_t sum_t_;
+  int32_t sum_r_;
+  int64_t sum_tt_;
+  int32_t sum_tr_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_RSSI_TREND_H_
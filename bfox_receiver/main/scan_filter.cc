@@ -0,0 +1,126 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "scan_filter.h"
+
+#include <cstring>
+
+#include "logger.h"
+
+// NimBLE Includes
+#include "host/ble_hs.h"
+
+namespace bfox_receiver_system {
+
+ScanFilter::ScanFilter()
+    : accept_list_(),
+      accept_list_size_(0),
+      accept_list_dirty_(false),
+      accept_list_overflow_(false),
+      phase_({.use_accept_list = false, .duration_ms = kScanPhaseMs}),
+      phase_start_ms_(0),
+      last_discovery_ms_(0),
+      phase_event_count_(0),
+      open_event_rate_(0),
+      filtered_event_rate_(0),
+      host_event_rate_(0),
+      avoided_event_rate_(0) {}
+
+ScanFilter::Phase ScanFilter::BeginPhase(const int64_t now_ms) {
+  RemoveExpiredAddresses(now_ms);
+
+  // Targets that did not fit would be filtered out, keep scanning open
+  bool use_accept_list = (accept_list_size_ != 0) && !accept_list_overflow_ &&
+                         (now_ms - last_discovery_ms_) < kDiscoveryIntervalMs;
+  if (use_accept_list && accept_list_dirty_ && !ApplyAcceptList()) {
+    use_accept_list = false;
+  }
+  if (!use_accept_list) {
+    last_discovery_ms_ = now_ms;
+    accept_list_overflow_ = false;
+  }
+
+  phase_ = {.use_accept_list = use_accept_list, .duration_ms = kScanPhaseMs};
+  phase_start_ms_ = now_ms;
+  phase_event_count_ = 0;
+  return phase_;
+}
+
+void ScanFilter::EndPhase(const int64_t now_ms) {
+  const int64_t elapsed_ms = now_ms - phase_start_ms_;
+  if (elapsed_ms <= 0) {
+    return;
+  }
+  const uint32_t rate =
+      static_cast<uint32_t>(phase_event_count_ * 1000ll / elapsed_ms);
+
+  // Smooth per phase type (1/4 new sample)
+  uint32_t& smoothed_rate =
+      phase_.use_accept_list ? filtered_event_rate_ : open_event_rate_;
+  smoothed_rate = (rate + smoothed_rate * 3) / 4;
+
+  host_event_rate_.store(rate, std::memory_order_relaxed);
+  if (phase_.use_accept_list) {
+    avoided_event_rate_.store((open_event_rate_ > filtered_event_rate_)
+                                  ? open_event_rate_ - filtered_event_rate_
+                                  : 0,
+                              std::memory_order_relaxed);
+  }
+}
+
+void ScanFilter::OnTargetSeen(const Address& address, const int64_t now_ms) {
+  for (size_t i = 0; i < accept_list_size_; ++i) {
+    AcceptListEntry& entry = accept_list_[i];
+    if (entry.address.type == address.type &&
+        std::memcmp(entry.address.value, address.value,
+                    sizeof(address.value)) == 0) {
+      entry.last_seen_ms = now_ms;
+      return;
+    }
+  }
+  if (accept_list_size_ < kMaxAcceptListSize) {
+    accept_list_[accept_list_size_++] = {.address = address,
+                                         .last_seen_ms = now_ms};
+    accept_list_dirty_ = true;
+  } else {
+    accept_list_overflow_ = true;
+  }
+}
+
+uint32_t ScanFilter::GetHostEventRate() const {
+  return host_event_rate_.load(std::memory_order_relaxed);
+}
+
+uint32_t ScanFilter::GetAvoidedEventRate() const {
+  return avoided_event_rate_.load(std::memory_order_relaxed);
+}
+
+void ScanFilter::RemoveExpiredAddresses(const int64_t now_ms) {
+  for (size_t i = 0; i < accept_list_size_;) {
+    if ((now_ms - accept_list_[i].last_seen_ms) > kAcceptListExpiryMs) {
+      accept_list_[i] = accept_list_[--accept_list_size_];
+      accept_list_dirty_ = true;
+    } else {
+      ++i;
+    }
+  }
+}
+
+bool ScanFilter::ApplyAcceptList() {
+  ble_addr_t addresses[kMaxAcceptListSize];
+  for (size_t i = 0; i < accept_list_size_; ++i) {
+    addresses[i].type = accept_list_[i].address.type;
+    std::memcpy(addresses[i].val, accept_list_[i].address.value,
+                sizeof(addresses[i].val));
+  }
+  const int rc = ble_gap_wl_set(addresses, accept_list_size_);
+  if (rc != 0) {
+    ESP_LOGW(kTag, "ble_gap_wl_set failed: %d", rc);
+    return false;
+  }
+  accept_list_dirty_ = false;
+  return true;
+}
+
+}  // namespace bfox_receiver_system
@@ -0,0 +1,87 @@
+#ifndef BFOX_RECEIVER_MAIN_SCAN_FILTER_H_
+#define BFOX_RECEIVER_MAIN_SCAN_FILTER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Controller-side scan filtering (NimBLE host task only).
+///
+/// Scanning runs in short phases with controller duplicate filtering. Each
+/// scan restart flushes the duplicate cache, so every beacon still reports
+/// about once per phase. Addresses of target beacons are learned into the
+/// controller accept list; between periodic open (discovery) phases the
+/// controller only reports those beacons and drops everything else.
+class ScanFilter final {
+ public:
+  static constexpr size_t kMaxAcceptListSize = 8;
+  static constexpr int32_t kScanPhaseMs = 500;  // duplicate cache reset period
+  static constexpr int64_t kDiscoveryIntervalMs = 5000;  // open scan period
+  static constexpr int64_t kAcceptListExpiryMs = 60000;
+
+  struct Address {
+    uint8_t type;
+    uint8_t value[6];
+  };
+
+  struct Phase {
+    bool use_accept_list;
+    int32_t duration_ms;
+  };
+
+ public:
+  ScanFilter();
+
+  /// Decide the next scan phase and load the accept list into the controller.
+  /// Must be called while scanning is stopped.
+  Phase BeginPhase(const int64_t now_ms);
+
+  /// Scan phase finished (BLE_GAP_EVENT_DISC_COMPLETE)
+  void EndPhase(const int64_t now_ms);
+
+  /// Every advertisement report delivered to the host
+  void OnHostEvent() { ++phase_event_count_; }
+
+  /// Advertisement from a target beacon
+  void OnTargetSeen(const Address& address, const int64_t now_ms);
+
+  /// Host advertisement events per second (current phase type)
+  uint32_t GetHostEventRate() const;
+
+  /// Estimated host events per second avoided by the accept list
+  uint32_t GetAvoidedEventRate() const;
+
+ private:
+  void RemoveExpiredAddresses(const int64_t now_ms);
+  bool ApplyAcceptList();
+
+ private:
+  struct AcceptListEntry {
+    Address address;
+    int64_t last_seen_ms;
+  };
+
+  AcceptListEntry accept_list_[kMaxAcceptListSize];
+  size_t accept_list_size_;
+  bool accept_list_dirty_;
+  bool accept_list_overflow_;  // a target did not fit since last discovery
+
+  Phase phase_;
+  int64_t phase_start_ms_;
+  int64_t last_discovery_ms_;
+  uint32_t phase_event_count_;
+
+  uint32_t open_event_rate_;      // events/s, open phases (smoothed)
+  uint32_t filtered_event_rate_;  // events/s, accept list phases (smoothed)
+  std::atomic<uint32_t> host_event_rate_;
+  std::atomic<uint32_t> avoided_event_rate_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SCAN_FILTER_H_
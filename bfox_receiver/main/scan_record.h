@@ -0,0 +1,22 @@
+#ifndef BFOX_RECEIVER_MAIN_SCAN_RECORD_H_
+#define BFOX_RECEIVER_MAIN_SCAN_RECORD_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Compact advertisement record passed from the NimBLE host task to the
+/// receive task.
+struct ScanRecord {
+  uint32_t timestamp_ms;  // esp_timer_get_time() / 1000 (truncated)
+  uint16_t minor;
+  int8_t rssi;
+  int8_t measured_power;  // advertised RSSI @1m
+  uint8_t group;          // index of the matched beacon group
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SCAN_RECORD_H_
@@ -0,0 +1,100 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "scan_scheduler.h"
+
+#include <algorithm>
+
+namespace bfox_receiver_system {
+
+ScanScheduler::ScanScheduler()
+    : policy_(Policy::kAdaptive),
+      beacon_adv_interval_ms_(kDefaultBeaconAdvIntervalMs),
+      user_active_until_ms_(0),
+      target_seen_ms_(0),  // scan fast for kTargetHoldMs after boot
+      phase_(),
+      phase_start_ms_(0),
+      first_phase_start_ms_(-1),
+      radio_on_ms_(0) {}
+
+ScanScheduler::ScanParams ScanScheduler::BeginPhase(
+    const int64_t now_ms, const int32_t min_duration_ms) {
+  const bool fast =
+      policy_.load(std::memory_order_relaxed) == Policy::kContinuous ||
+      (now_ms - target_seen_ms_) < kTargetHoldMs ||
+      now_ms < user_active_until_ms_.load(std::memory_order_relaxed);
+
+  if (fast) {
+    phase_ = {.itvl = MsToUnits(kFastIntervalMs),
+              .window = MsToUnits(kFastIntervalMs),
+              .duration_ms = min_duration_ms,
+              .fast = true};
+  } else {
+    // Window covers one advertising interval, interval spaces windows out.
+    // Phase spans a whole interval so every phase contains one window.
+    const uint32_t window_ms = std::min(
+        beacon_adv_interval_ms_.load(std::memory_order_relaxed) +
+            kAdvDelayMarginMs,
+        kMaxScanIntervalMs);
+    const uint32_t interval_ms =
+        std::min(window_ms * kIdleDutyDivider, kMaxScanIntervalMs);
+    phase_ = {.itvl = MsToUnits(interval_ms),
+              .window = MsToUnits(window_ms),
+              .duration_ms = std::max(min_duration_ms,
+                                      static_cast<int32_t>(interval_ms)),
+              .fast = false};
+  }
+
+  if (first_phase_start_ms_.load(std::memory_order_relaxed) < 0) {
+    first_phase_start_ms_.store(now_ms, std::memory_order_relaxed);
+  }
+  phase_start_ms_ = now_ms;
+  return phase_;
+}
+
+void ScanScheduler::EndPhase(const int64_t now_ms) {
+  const int64_t elapsed_ms = now_ms - phase_start_ms_;
+  if (elapsed_ms <= 0 || phase_.itvl == 0) {
+    return;
+  }
+  // Windows start at the beginning of each interval
+  const int64_t itvl_ms = phase_.itvl * 5 / 8;
+  const int64_t window_ms = phase_.window * 5 / 8;
+  const int64_t on_ms = (elapsed_ms / itvl_ms) * window_ms +
+                        std::min(elapsed_ms % itvl_ms, window_ms);
+  radio_on_ms_.fetch_add(on_ms, std::memory_order_relaxed);
+}
+
+void ScanScheduler::OnTargetSeen(const int64_t now_ms) {
+  target_seen_ms_ = now_ms;
+}
+
+void ScanScheduler::OnUserActivity(const int64_t now_ms) {
+  user_active_until_ms_.store(now_ms + kUserHoldMs, std::memory_order_relaxed);
+}
+
+void ScanScheduler::SetPolicy(const Policy policy) {
+  policy_.store(policy, std::memory_order_relaxed);
+}
+
+void ScanScheduler::SetBeaconAdvIntervalMs(const uint32_t adv_interval_ms) {
+  beacon_adv_interval_ms_.store(
+      (adv_interval_ms != 0) ? adv_interval_ms : kDefaultBeaconAdvIntervalMs,
+      std::memory_order_relaxed);
+}
+
+int64_t ScanScheduler::GetRadioOnMs() const {
+  return radio_on_ms_.load(std::memory_order_relaxed);
+}
+
+uint32_t ScanScheduler::GetDutyPerMille(const int64_t now_ms) const {
+  const int64_t start_ms =
+      first_phase_start_ms_.load(std::memory_order_relaxed);
+  if (start_ms < 0 || now_ms <= start_ms) {
+    return 0;
+  }
+  return static_cast<uint32_t>(GetRadioOnMs() * 1000 / (now_ms - start_ms));
+}
+
+}  // namespace bfox_receiver_system
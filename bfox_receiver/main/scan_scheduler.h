@@ -0,0 +1,90 @@
+#ifndef BFOX_RECEIVER_MAIN_SCAN_SCHEDULER_H_
+#define BFOX_RECEIVER_MAIN_SCAN_SCHEDULER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <atomic>
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Scan duty cycle scheduler.
+///
+/// Scans continuously while a target beacon was seen recently or the user
+/// is active, otherwise drops to a low duty cycle. The idle window is longer
+/// than the beacon advertising interval so every idle window catches at
+/// least one advertising event (discovery latency <= one idle interval).
+/// Beyond kMaxIdleAdvIntervalMs the scan interval limit raises the idle
+/// duty instead, up to continuous scanning.
+class ScanScheduler final {
+ public:
+  enum class Policy : int32_t {
+    kContinuous,  // always 100% duty (previous behavior)
+    kAdaptive,
+  };
+
+  static constexpr uint32_t kDefaultBeaconAdvIntervalMs = 500;
+  static constexpr uint32_t kAdvDelayMarginMs = 10;  // advDelay 0-10ms
+  static constexpr uint32_t kIdleDutyDivider = 4;    // idle duty 25%
+  static constexpr uint32_t kMaxScanIntervalMs = 10240;  // BLE limit
+  static constexpr uint32_t kMaxIdleAdvIntervalMs =
+      kMaxScanIntervalMs / kIdleDutyDivider - kAdvDelayMarginMs;
+  static constexpr int64_t kTargetHoldMs = 10000;    // fast after last target
+  static constexpr int64_t kUserHoldMs = 10000;      // fast after button
+
+  static constexpr uint32_t kFastIntervalMs = 100;
+
+  struct ScanParams {
+    uint16_t itvl;    // 0.625ms unit
+    uint16_t window;  // 0.625ms unit
+    int32_t duration_ms;
+    bool fast;
+  };
+
+ public:
+  ScanScheduler();
+
+  /// Parameters for the next scan phase (NimBLE host task)
+  ScanParams BeginPhase(const int64_t now_ms, const int32_t min_duration_ms);
+
+  /// Scan phase finished (NimBLE host task)
+  void EndPhase(const int64_t now_ms);
+
+  /// Target beacon received (NimBLE host task)
+  void OnTargetSeen(const int64_t now_ms);
+
+  /// Button pressed (any task)
+  void OnUserActivity(const int64_t now_ms);
+
+  void SetPolicy(const Policy policy);
+
+  /// Longest advertising interval of the tracked beacons (0: default)
+  void SetBeaconAdvIntervalMs(const uint32_t adv_interval_ms);
+
+  /// Estimated accumulated radio-on (scan window) time [ms]
+  int64_t GetRadioOnMs() const;
+
+  /// Radio-on ratio since start [per mille]
+  uint32_t GetDutyPerMille(const int64_t now_ms) const;
+
+ private:
+  static uint16_t MsToUnits(const uint32_t ms) {
+    return static_cast<uint16_t>(ms * 8 / 5);  // 0.625ms unit
+  }
+
+ private:
+  std::atomic<Policy> policy_;
+  std::atomic<uint32_t> beacon_adv_interval_ms_;
+  std::atomic<int64_t> user_active_until_ms_;
+  int64_t target_seen_ms_;
+
+  ScanParams phase_;
+  int64_t phase_start_ms_;
+  std::atomic<int64_t> first_phase_start_ms_;
+  std::atomic<int64_t> radio_on_ms_;
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SCAN_SCHEDULER_H_
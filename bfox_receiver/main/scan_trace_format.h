@@ -0,0 +1,45 @@
+#ifndef BFOX_RECEIVER_MAIN_SCAN_TRACE_FORMAT_H_
+#define BFOX_RECEIVER_MAIN_SCAN_TRACE_FORMAT_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Scan trace file layout, shared by ScanTraceRecorder and the host replay
+// tool
+
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Trace file layout (little endian):
+///   ScanTraceHeader, then ScanTraceRecord until the end of the file.
+/// Replaying a record into BeaconTracker::Update needs a ScanRecord with
+/// timestamp_ms = start_ms + sum of dt_ms.
+struct __attribute__((packed)) ScanTraceHeader {
+  char magic[4];  // "BFTR"
+  uint8_t version;
+  uint8_t record_size;
+  uint16_t reserved;
+  uint32_t start_ms;  // esp_timer_get_time() / 1000 (truncated)
+};
+
+struct __attribute__((packed)) ScanTraceRecord {
+  uint16_t dt_ms;  // since the previous record
+  uint16_t minor;
+  int8_t rssi;
+  int8_t measured_power;
+  uint8_t group;    // kTimeGapGroup: no beacon, only advances time
+  uint8_t channel;  // kUnknownChannel: not reported by the controller
+};
+static_assert(sizeof(ScanTraceRecord) == 8, "Trace record layout changed");
+
+namespace scan_trace {
+
+constexpr char kMagic[4] = {'B', 'F', 'T', 'R'};
+constexpr uint8_t kVersion = 1;
+constexpr uint8_t kTimeGapGroup = 0xFF;
+constexpr uint8_t kUnknownChannel = 0xFF;
+
+}  // namespace scan_trace
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SCAN_TRACE_FORMAT_H_
@@ -0,0 +1,226 @@
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include "scan_trace_recorder.h"
+
+#include <esp_timer.h>
+#include <esp_vfs_fat.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cinttypes>
+#include <cstring>
+
+#include "logger.h"
+#include "util.h"
+
+namespace bfox_receiver_system {
+
+ScanTraceRecorder::ScanTraceRecorder()
+    : StaticTask(kTaskName, kPriority, kCoreId),
+      full_blocks_(),
+      wl_handle_(WL_INVALID_HANDLE),
+      file_mutex_(),
+      file_(nullptr),
+      mutex_(),
+      blocks_(),
+      block_busy_(),
+      active_block_(0),
+      opened_(false),
+      closed_(false),
+      last_timestamp_ms_(0),
+      record_count_(0),
+      dropped_count_(0) {}
+
+ScanTraceRecorder::~ScanTraceRecorder() { Close(); }
+
+void ScanTraceRecorder::Initialize() {
+  if (!full_blocks_.Create()) {
+    ESP_LOGE(kTag, "Creating queue failed");
+    Stop();
+    return;
+  }
+
+  std::scoped_lock lock(mutex_);
+  opened_ = !closed_ && Open();
+  if (!opened_) {
+    if (wl_handle_ != WL_INVALID_HANDLE) {
+      esp_vfs_fat_spiflash_unmount_rw_wl(kBasePath, wl_handle_);
+      wl_handle_ = WL_INVALID_HANDLE;
+    }
+    Stop();  // recording disabled for this session
+  }
+}
+
+void ScanTraceRecorder::Update() {
+  // The block index sent is a hint only; the timeout also picks up blocks
+  // handed over before this task first waited
+  uint32_t index = 0;
+  constexpr int32_t kNotifyWaitLimitMs = 1000;
+  full_blocks_.ReceiveWait(&index, kNotifyWaitLimitMs);
+  WriteBusyBlocks();
+}
+
+void ScanTraceRecorder::Append(const ScanRecord& record) {
+  std::scoped_lock lock(mutex_);
+  if (!opened_ || closed_) {
+    return;
+  }
+
+  uint32_t dt_ms = record.timestamp_ms - last_timestamp_ms_;
+  last_timestamp_ms_ = record.timestamp_ms;
+  while (dt_ms > UINT16_MAX) {
+    Push({.dt_ms = UINT16_MAX,
+          .minor = 0,
+          .rssi = 0,
+          .measured_power = 0,
+          .group = scan_trace::kTimeGapGroup,
+          .channel = scan_trace::kUnknownChannel});
+    dt_ms -= UINT16_MAX;
+  }
+  Push({.dt_ms = static_cast<uint16_t>(dt_ms),
+        .minor = record.minor,
+        .rssi = record.rssi,
+        .measured_power = record.measured_power,
+        .group = record.group,
+        .channel = scan_trace::kUnknownChannel});
+}
+
+void ScanTraceRecorder::Close() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    if (!opened_) {
+      return;
+    }
+    // Hand over the partial block
+    if (blocks_[active_block_].count != 0 && !block_busy_[active_block_]) {
+      HandOver(active_block_);
+    }
+  }
+
+  // Wait for the writer
+  constexpr int kMaxWaitCount = 100;
+  for (int i = 0; i < kMaxWaitCount && (block_busy_[0] || block_busy_[1]);
+       ++i) {
+    util::SleepMillisecond(10);
+  }
+  // Left over when the writer is not running
+  WriteBusyBlocks();
+
+  std::scoped_lock lock(mutex_, file_mutex_);
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+  esp_vfs_fat_spiflash_unmount_rw_wl(kBasePath, wl_handle_);
+  wl_handle_ = WL_INVALID_HANDLE;
+  opened_ = false;
+  ESP_LOGI(kTag, "Scan trace closed. records:%" PRIu32 " dropped:%" PRIu32,
+           record_count_.load(), dropped_count_.load());
+}
+
+bool ScanTraceRecorder::Open() {
+  esp_vfs_fat_mount_config_t mount_config = {};
+  mount_config.format_if_mount_failed = true;
+  mount_config.max_files = 2;
+  mount_config.allocation_unit_size = CONFIG_WL_SECTOR_SIZE;
+  const esp_err_t ret = esp_vfs_fat_spiflash_mount_rw_wl(
+      kBasePath, kPartitionLabel, &mount_config, &wl_handle_);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "Mounting FAT partition failed: %s", esp_err_to_name(ret));
+    return false;
+  }
+
+  // One file per session, first unused name
+  char path[32] = {};
+  int file_no = 0;
+  struct stat st;
+  for (; file_no < kMaxFileNum; ++file_no) {
+    snprintf(path, sizeof(path), "%s/scan%03d.bin", kBasePath, file_no);
+    if (stat(path, &st) != 0) {
+      break;
+    }
+  }
+  if (file_no == kMaxFileNum) {
+    ESP_LOGE(kTag, "No free scan trace file name");
+    return false;
+  }
+
+  file_ = fopen(path, "wb");
+  if (file_ == nullptr) {
+    ESP_LOGE(kTag, "Opening %s failed", path);
+    return false;
+  }
+
+  last_timestamp_ms_ = static_cast<uint32_t>(esp_timer_get_time() / 1000);
+  ScanTraceHeader header = {.version = scan_trace::kVersion,
+                            .record_size = sizeof(ScanTraceRecord),
+                            .reserved = 0,
+                            .start_ms = last_timestamp_ms_};
+  std::memcpy(header.magic, scan_trace::kMagic, sizeof(header.magic));
+  fwrite(&header, sizeof(header), 1, file_);
+  fflush(file_);
+
+  ESP_LOGI(kTag, "Scan trace recording to %s", path);
+  return true;
+}
+
+void ScanTraceRecorder::Push(const ScanTraceRecord& record) {
+  if (block_busy_[active_block_]) {
+    ++dropped_count_;  // both blocks wait for the flash
+    return;
+  }
+
+  Block& block = blocks_[active_block_];
+  block.records[block.count++] = record;
+  ++record_count_;
+  if (block.count == kBlockRecordNum) {
+    HandOver(active_block_);
+  }
+}
+
+void ScanTraceRecorder::HandOver(const size_t index) {
+  block_busy_[index] = true;
+  active_block_ = index ^ 1;
+  // Fails while a notification is pending or before the writer first
+  // waited; the block is written either way
+  full_blocks_.Send(static_cast<uint32_t>(index));
+}
+
+void ScanTraceRecorder::WriteBusyBlocks() {
+  size_t first = 0;
+  {
+    std::scoped_lock lock(mutex_);
+    first = block_busy_[active_block_] ? active_block_ : active_block_ ^ 1;
+  }
+  WriteBlock(first);
+  WriteBlock(first ^ 1);
+}
+
+void ScanTraceRecorder::WriteBlock(const size_t index) {
+  Block& block = blocks_[index];
+  std::scoped_lock lock(file_mutex_);
+  if (!block_busy_[index]) {
+    return;  // already written, or still being filled
+  }
+  if (file_ != nullptr) {
+    const size_t written =
+        fwrite(block.records, sizeof(ScanTraceRecord), block.count, file_);
+    fflush(file_);
+    fsync(fileno(file_));
+    if (written != block.count) {
+      ESP_LOGE(kTag, "Scan trace write failed, storage full?");
+      fclose(file_);
+      file_ = nullptr;
+    }
+  }
+  block.count = 0;
+  block_busy_[index] = false;
+}
+
+}  // namespace bfox_receiver_system
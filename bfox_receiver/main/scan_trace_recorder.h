@@ -0,0 +1,96 @@
+#ifndef BFOX_RECEIVER_MAIN_SCAN_TRACE_RECORDER_H_
+#define BFOX_RECEIVER_MAIN_SCAN_TRACE_RECORDER_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <wear_levelling.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+#include "message_queue.h"
+#include "scan_record.h"
+#include "scan_trace_format.h"
+#include "task.h"
+
+namespace bfox_receiver_system {
+
+/// Records accepted scan events to the FAT "storage" partition.
+///
+/// The receive task appends into one of two RAM blocks; a full block is
+/// handed to this task, which writes it in one call. Flash latency never
+/// reaches the receive or NimBLE host tasks; records are dropped when both
+/// blocks wait for the flash.
+///
+/// The hand-over wakes the writer with a task notification. It holds one
+/// value and sends fail while it is pending, so the writer treats it as a
+/// wake-up only and writes every busy block, oldest first.
+class ScanTraceRecorder final : public StaticTask<ScanTraceRecorder> {
+ public:
+  static constexpr const char* kTaskName = "ScanTraceRecorder";
+  static constexpr int kPriority = Task::kPriorityLow;
+  static constexpr int kCoreId = tskNO_AFFINITY;
+  static constexpr uint32_t kStackDepth = 4096;  // [byte] FAT + wear levelling
+
+  static constexpr const char* kBasePath = "/storage";
+  static constexpr const char* kPartitionLabel = "storage";
+  static constexpr size_t kBlockSize = 4096;  // bytes per flash write
+  static constexpr size_t kBlockRecordNum =
+      kBlockSize / sizeof(ScanTraceRecord);
+  static constexpr int kMaxFileNum = 1000;  // scan000.bin - scan999.bin
+
+ public:
+  ScanTraceRecorder();
+  ~ScanTraceRecorder();
+
+  void Initialize() override;
+  void Update() override;
+
+  /// Receive task only
+  void Append(const ScanRecord& record);
+
+  /// Write buffered records and close the file (before Deep Sleep)
+  void Close();
+
+  uint32_t GetRecordCount() const { return record_count_.load(); }
+  uint32_t GetDroppedCount() const { return dropped_count_.load(); }
+
+ private:
+  struct Block {
+    ScanTraceRecord records[kBlockRecordNum];
+    size_t count;
+  };
+
+  bool Open();
+  void Push(const ScanTraceRecord& record);
+  void HandOver(const size_t index);
+  void WriteBusyBlocks();
+  void WriteBlock(const size_t index);
+
+ private:
+  MessageQueue<uint32_t, TaskNotifyBackend> full_blocks_;  // writer wake-up
+  wl_handle_t wl_handle_;
+  std::mutex file_mutex_;  // writer / Close
+  FILE* file_;
+
+  std::mutex mutex_;  // Append / Close
+  Block blocks_[2];
+  std::atomic<bool> block_busy_[2];  // handed to the writer
+  size_t active_block_;  // the older one when both are busy
+  bool opened_;
+  bool closed_;
+  uint32_t last_timestamp_ms_;
+
+  std::atomic<uint32_t> record_count_;
+  std::atomic<uint32_t> dropped_count_;
+};
+
+using ScanTraceRecorderUniquePtr = std::unique_ptr<ScanTraceRecorder>;
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SCAN_TRACE_RECORDER_H_
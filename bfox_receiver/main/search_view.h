@@ -0,0 +1,94 @@
+#ifndef BFOX_RECEIVER_MAIN_SEARCH_VIEW_H_
+#define BFOX_RECEIVER_MAIN_SEARCH_VIEW_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+// Search mode screen, rendered to plain character rows (no LCD access)
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "ble_beacon_item.h"
+#include "rssi_indicator.h"
+
+namespace bfox_receiver_system {
+
+namespace search_view {
+
+constexpr size_t kLcdCols = 16;
+constexpr size_t kLcdLines = 2;
+
+/// LCD character codes, rows are not terminated
+struct Frame {
+  uint8_t rows[kLcdLines][kLcdCols];
+};
+
+/// Fills a row left to right, clipped at the last column, padded with spaces
+class RowBuilder final {
+ public:
+  explicit RowBuilder(uint8_t* const row) : row_(row), col_(0) {
+    std::memset(row_, ' ', kLcdCols);
+  }
+
+  void Append(const uint8_t* data, size_t size) {
+    while (size-- > 0 && col_ < kLcdCols) {
+      row_[col_++] = *data++;
+    }
+  }
+
+  void Append(const char* const str) {
+    Append(reinterpret_cast<const uint8_t*>(str), std::strlen(str));
+  }
+
+ private:
+  uint8_t* row_;
+  size_t col_;
+};
+
+/// "minor|<bar>|distance", the first separator is a trend arrow when known
+inline void RenderBeaconRow(const BleBeaconItem& info,
+                            uint8_t row[kLcdCols]) {
+  RowBuilder builder(row);
+
+  char text[16];
+  std::snprintf(text, sizeof(text), "%u", static_cast<unsigned>(info.minor));
+  builder.Append(text);
+  const uint8_t trend = rssi_indicator::RenderTrend(info.trend);
+  builder.Append(&trend, 1);
+
+  uint8_t bar[rssi_indicator::kCellNum];
+  rssi_indicator::Render(rssi_indicator::GetLevel(info.rssi), bar);
+  builder.Append(bar, sizeof(bar));
+
+  // Estimated distance [m]
+  const unsigned long distance_cm = info.distance_cm;
+  char distance[12] = {};
+  if (distance_cm < 10000) {
+    std::snprintf(distance, sizeof(distance), "%lu.%lum", distance_cm / 100,
+                  (distance_cm % 100) / 10);
+  } else {
+    std::snprintf(distance, sizeof(distance), "%lum", distance_cm / 100);
+  }
+  std::snprintf(text, sizeof(text), "|%-7s", distance);
+  builder.Append(text);
+}
+
+/// Strongest beacons first, "NO SIGNAL" without any
+template <typename RankedItems>
+void Render(const RankedItems& ranked_items, Frame* const frame) {
+  for (size_t line = 0; line < kLcdLines; ++line) {
+    RowBuilder builder(frame->rows[line]);
+    if (line < ranked_items.count) {
+      RenderBeaconRow(ranked_items.items[line], frame->rows[line]);
+    } else if (line == 0) {
+      builder.Append("NO SIGNAL");
+    }
+  }
+}
+
+}  // namespace search_view
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SEARCH_VIEW_H_
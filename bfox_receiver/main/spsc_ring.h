@@ -0,0 +1,92 @@
+#ifndef BFOX_RECEIVER_MAIN_SPSC_RING_H_
+#define BFOX_RECEIVER_MAIN_SPSC_RING_H_
+// ESP32 B-Fox Receiver
+// (C)2025 bekki.jp
+
+// Include ----------------------
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace bfox_receiver_system {
+
+/// Fixed-capacity single-producer/single-consumer lock-free ring.
+/// Push() must only be called from one task (producer) and Pop() from one
+/// other task (consumer). When the ring is full new items are dropped.
+template <typename T, size_t kCapacity>
+class SpscRing {
+ public:
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0,
+                "kCapacity must be a power of two");
+
+ private:
+  static constexpr uint32_t kIndexMask = kCapacity - 1;
+
+ public:
+  SpscRing()
+      : buffer_(),
+        head_(0),
+        tail_(0),
+        overflow_count_(0),
+        dropped_count_(0),
+        is_overflowing_(false) {}
+
+  /// Push (producer only)
+  bool Push(const T& item) {
+    const uint32_t head = head_.load(std::memory_order_relaxed);
+    const uint32_t tail = tail_.load(std::memory_order_acquire);
+    if ((head - tail) >= kCapacity) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      if (!is_overflowing_) {
+        is_overflowing_ = true;
+        overflow_count_.fetch_add(1, std::memory_order_relaxed);
+      }
+      return false;
+    }
+    buffer_[head & kIndexMask] = item;
+    head_.store(head + 1, std::memory_order_release);
+    is_overflowing_ = false;
+    return true;
+  }
+
+  /// Pop (consumer only)
+  bool Pop(T* const item) {
+    const uint32_t tail = tail_.load(std::memory_order_relaxed);
+    const uint32_t head = head_.load(std::memory_order_acquire);
+    if (head == tail) {
+      return false;
+    }
+    *item = buffer_[tail & kIndexMask];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t Size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t Capacity() { return kCapacity; }
+
+  /// Number of times the ring became full (one count per overflow burst)
+  uint32_t GetOverflowCount() const {
+    return overflow_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Number of items discarded because the ring was full
+  uint32_t GetDroppedCount() const {
+    return dropped_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  T buffer_[kCapacity];
+  std::atomic<uint32_t> head_;  // written by producer
+  std::atomic<uint32_t> tail_;  // written by consumer
+  std::atomic<uint32_t> overflow_count_;
+  std::atomic<uint32_t> dropped_count_;
+  bool is_overflowing_;  // producer only
+};
+
+}  // namespace bfox_receiver_system
+
+#endif  // BFOX_RECEIVER_MAIN_SPSC_RING_H_
@@ -2,37 +2,52 @@
 
 #include <rom/ets_sys.h>
 
+#include <algorithm>
+#include <cinttypes>
 #include <memory>
 
+#include "logger.h"
+
 namespace bfox_receiver_system {
 
 ST7032::ST7032()
-    : i2c_port_(),
-      i2c_address_(),
+    : bus_handle_(nullptr),
+      dev_handle_(nullptr),
+      tx_slots_(),
+      next_tx_slot_(0),
+      free_tx_slots_(nullptr),
+      pending_count_(0),
+      error_count_(0),
+      transfer_done_callback_(nullptr),
+      transfer_done_callback_arg_(nullptr),
       display_function_(),
       display_control_(),
       display_mode_(),
       num_lines_(),
-      cur_line_() {}
+      num_cols_(),
+      cur_line_(),
+      cur_col_(),
+      ddram_address_(kInvalidAddress),
+      shadow_(),
+      transaction_count_(0),
+      transferred_bytes_(0) {}
+
+ST7032::~ST7032() {
+  if (dev_handle_ != nullptr) {
+    WaitDone();
+    i2c_master_bus_rm_device(dev_handle_);
+  }
+  if (free_tx_slots_ != nullptr) {
+    vSemaphoreDelete(free_tx_slots_);
+  }
+}
 
 // Initialize
-void ST7032::Setup(i2c_port_t i2c_port, const uint8_t address,
+void ST7032::Setup(i2c_master_bus_handle_t bus_handle, const uint8_t address,
                    const uint8_t cols, const uint8_t lines,
-                   const uint8_t charsize) {
-  i2c_port_ = i2c_port;
-  i2c_address_ = address;
-
-  display_function_ = kLcd8bitmode | kLcd1line | kLcd5x8dots;
-
-  if (lines > 1) {
-    display_function_ |= kLcd2line;
-  }
-  num_lines_ = lines;
-  cur_line_ = 0;
-
-  // for some 1 line displays you can select a 10 pixel high font
-  if ((charsize != 0) && (lines == 1)) {
-    display_function_ |= kLcd5x10dots;
+                   const uint8_t charsize, const uint32_t scl_speed_hz) {
+  if (!Attach(bus_handle, address, cols, lines, charsize, scl_speed_hz)) {
+    return;
   }
 
   // Wait for power on
@@ -44,6 +59,7 @@ void ST7032::Setup(i2c_port_t i2c_port, const uint8_t address,
   ExtendFunctionSet();
   Command(kLcdExSetbiasosc | kLcdBias1_5 | kLcdOsc183hz);
   Command(kLcdExFollowercontrol | kLcdFollowerOn | kLcdRab2_00);
+  WaitDone();
   vTaskDelay(200 / portTICK_PERIOD_MS);  // 200ms
   NormalFunctionSet();
 
@@ -58,6 +74,67 @@ void ST7032::Setup(i2c_port_t i2c_port, const uint8_t address,
   SetEntryMode(kLcdEntryleft | kLcdEntryshiftdecrement);
 }
 
+bool ST7032::Attach(i2c_master_bus_handle_t bus_handle, const uint8_t address,
+                    const uint8_t cols, const uint8_t lines,
+                    const uint8_t charsize, const uint32_t scl_speed_hz) {
+  if (bus_handle == nullptr || dev_handle_ != nullptr) {
+    return false;
+  }
+
+  free_tx_slots_ = xSemaphoreCreateCounting(kTxSlotNum, kTxSlotNum);
+  if (free_tx_slots_ == nullptr) {
+    ESP_LOGE(kTag, "ST7032 creating semaphore failed");
+    return false;
+  }
+
+  i2c_device_config_t device_config = {};
+  device_config.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+  device_config.device_address = address;
+  device_config.scl_speed_hz = std::min(scl_speed_hz, kI2cMaxDataHz);
+  if (scl_speed_hz > kI2cMaxDataHz) {
+    ESP_LOGW(kTag, "ST7032 SCL limited to %" PRIu32 "Hz", kI2cMaxDataHz);
+  }
+  esp_err_t ret =
+      i2c_master_bus_add_device(bus_handle, &device_config, &dev_handle_);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "ST7032 adding device failed: %s", esp_err_to_name(ret));
+    dev_handle_ = nullptr;
+    return false;
+  }
+
+  // Registering the callback makes i2c_master_transmit non-blocking
+  i2c_master_event_callbacks_t callbacks = {};
+  callbacks.on_trans_done = &ST7032::OnTransDone;
+  ret = i2c_master_register_event_callbacks(dev_handle_, &callbacks, this);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "ST7032 registering callback failed: %s",
+             esp_err_to_name(ret));
+  }
+  bus_handle_ = bus_handle;
+
+  display_function_ = kLcd8bitmode | kLcd1line | kLcd5x8dots;
+
+  if (lines > 1) {
+    display_function_ |= kLcd2line;
+  }
+  num_lines_ = std::min(lines, kMaxLines);
+  num_cols_ = std::min(cols, kMaxCols);
+  cur_line_ = 0;
+  cur_col_ = 0;
+
+  // for some 1 line displays you can select a 10 pixel high font
+  if ((charsize != 0) && (lines == 1)) {
+    display_function_ |= kLcd5x10dots;
+  }
+
+  // State Setup leaves the controller in (display on, cleared)
+  display_control_ = kLcdDisplayon | kLcdCursoroff | kLcdBlinkoff;
+  display_mode_ = kLcdEntryleft | kLcdEntryshiftdecrement;
+  std::memset(shadow_, ' ', sizeof(shadow_));
+  ddram_address_ = kInvalidAddress;
+  return true;
+}
+
 void ST7032::SetContrast(uint8_t cont) {
   ExtendFunctionSet();
   Command(kLcdExContrastsetl | (cont & 0x0f));
@@ -68,15 +145,19 @@ void ST7032::SetContrast(uint8_t cont) {
 
 void ST7032::Clear() {
   Command(kLcdClearDisplay);
+  WaitDone();
   ets_delay_us(2000);
+
+  std::memset(shadow_, ' ', sizeof(shadow_));
+  ddram_address_ = 0;
+  cur_line_ = 0;
+  cur_col_ = 0;
 }
 
 void ST7032::SetCursor(uint8_t col, uint8_t row) {
-  const int row_offsets[] = {0x00, 0x40, 0x14, 0x54};
-  if (row > num_lines_) {
-    row = num_lines_ - 1;
-  }
-  Command(kLcdSetDDRRamAddr | (col + row_offsets[row]));
+  // The address is sent with the first changed cell
+  cur_line_ = std::min<uint8_t>(row, num_lines_ - 1);
+  cur_col_ = std::min(col, num_cols_);
 }
 
 void ST7032::Print(const std::string &s) {
@@ -108,7 +189,7 @@ void ST7032::Vprintf(const char *format, va_list arg) {
     return;
   }
 
-  if (len < STACK_BUF_SIZE) {
+  if (static_cast<size_t>(len) < STACK_BUF_SIZE) {
     // If the stack buffer is sufficient
     Write(reinterpret_cast<uint8_t *>(stack_buf), len);
   } else {
@@ -120,41 +201,125 @@ void ST7032::Vprintf(const char *format, va_list arg) {
 }
 
 void ST7032::Command(const uint8_t value) {
-  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-  i2c_master_start(cmd);
+  // Execution takes 26.3us, covered by the START, address and control bytes
+  // of the next transfer (190us at 100kHz)
+  Transmit(0x00, &value, 1);
+}
+
+void ST7032::Write(const uint8_t *buffer, size_t size) {
+  // Characters past the last visible column are dropped
+  const uint8_t start_col = cur_col_;
+  const size_t span = std::min<size_t>(size, num_cols_ - start_col);
+  uint8_t *const line = &shadow_[cur_line_][start_col];
+  cur_col_ += span;
+
+  size_t begin = 0;
+  while (begin < span) {
+    if (line[begin] == buffer[begin]) {
+      ++begin;
+      continue;
+    }
+
+    // Extend the run over short gaps of unchanged cells
+    size_t end = begin + 1;
+    size_t gap = 0;
+    for (size_t i = end; i < span && gap <= kMaxRunGap; ++i) {
+      if (line[i] != buffer[i]) {
+        end = i + 1;
+        gap = 0;
+      } else {
+        ++gap;
+      }
+    }
+
+    const int row_offsets[] = {0x00, 0x40, 0x14, 0x54};
+    SetDdramAddress(row_offsets[cur_line_] + start_col + begin);
+    WriteData(&buffer[begin], end - begin);
+    std::memcpy(&line[begin], &buffer[begin], end - begin);
+    begin = end;
+  }
+}
+
+void ST7032::Write(const uint8_t value) { Write(&value, 1); }
 
-  i2c_master_write_byte(cmd, i2c_address_ << 1 | I2C_MASTER_WRITE, true);
-  i2c_master_write_byte(cmd, 0x00, true);
-  i2c_master_write_byte(cmd, value, true);
+void ST7032::CreateChar(const uint8_t location, const uint8_t charmap[8]) {
+  Command(kLcdSetCGRamAddr | ((location & 0x07) << 3));
+  Transmit(0x40, charmap, 8);
+  // Address counter now points into CGRAM
+  ddram_address_ = kInvalidAddress;
+}
 
-  i2c_master_stop(cmd);
+void ST7032::SetDdramAddress(const uint8_t address) {
+  if (ddram_address_ != address) {
+    Command(kLcdSetDDRRamAddr | address);
+    ddram_address_ = address;
+  }
+}
 
-  i2c_master_cmd_begin(i2c_port_, cmd, 1000 / portTICK_PERIOD_MS);
-  i2c_cmd_link_delete(cmd);
+void ST7032::WriteData(const uint8_t *data, const size_t size) {
+  // Continuous data bytes after a single control byte (Co = 0, RS = 1).
+  // Each byte is written to RAM (26.3us) while the next one is clocked in,
+  // 90us per byte at 100kHz; kI2cMaxDataHz keeps this above 27us.
+  Transmit(0x40, data, size);
+  ddram_address_ += size;
+}
 
-  ets_delay_us(27);  // 26.3us
+void ST7032::SetTransferDoneCallback(TransferDoneCallback callback,
+                                     void *arg) {
+  WaitDone();
+  transfer_done_callback_ = callback;
+  transfer_done_callback_arg_ = arg;
 }
 
-void ST7032::Write(const uint8_t *buffer, size_t size) {
-  while (size--) {
-    Write(*buffer++);
+void ST7032::WaitDone() {
+  if (bus_handle_ == nullptr) {
+    return;
   }
+  i2c_master_bus_wait_all_done(bus_handle_, -1);
 }
 
-void ST7032::Write(const uint8_t value) {
-  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-  i2c_master_start(cmd);
+void ST7032::Transmit(const uint8_t control, const uint8_t *data,
+                      const size_t size) {
+  if (dev_handle_ == nullptr || size > kMaxCols) {
+    return;
+  }
 
-  i2c_master_write_byte(cmd, i2c_address_ << 1 | I2C_MASTER_WRITE, true);
-  i2c_master_write_byte(cmd, 0x40, true);
-  i2c_master_write_byte(cmd, value, true);
+  // Oldest slot, free once its transfer completed
+  xSemaphoreTake(free_tx_slots_, portMAX_DELAY);
+  uint8_t *const slot = tx_slots_[next_tx_slot_];
+  next_tx_slot_ = (next_tx_slot_ + 1) % kTxSlotNum;
+  slot[0] = control;
+  std::memcpy(&slot[1], data, size);
+
+  pending_count_.fetch_add(1);
+  const esp_err_t ret =
+      i2c_master_transmit(dev_handle_, slot, 1 + size, kTransmitTimeoutMs);
+  if (ret != ESP_OK) {
+    ESP_LOGE(kTag, "ST7032 transmit failed: %s", esp_err_to_name(ret));
+    pending_count_.fetch_sub(1);
+    xSemaphoreGive(free_tx_slots_);
+    return;
+  }
+  ++transaction_count_;
+  transferred_bytes_ += 1 + size;
+}
 
-  i2c_master_stop(cmd);
+bool ST7032::OnTransDone(i2c_master_dev_handle_t dev_handle,
+                         const i2c_master_event_data_t *event_data,
+                         void *arg) {
+  ST7032 *const self = static_cast<ST7032 *>(arg);
+  if (event_data->event != I2C_EVENT_DONE) {
+    self->error_count_.fetch_add(1);
+  }
 
-  i2c_master_cmd_begin(i2c_port_, cmd, 1000 / portTICK_PERIOD_MS);
-  i2c_cmd_link_delete(cmd);
+  BaseType_t high_task_wakeup = pdFALSE;
+  xSemaphoreGiveFromISR(self->free_tx_slots_, &high_task_wakeup);
 
-  ets_delay_us(27);  // 26.3us
+  if (self->pending_count_.fetch_sub(1) == 1 &&
+      self->transfer_done_callback_ != nullptr) {
+    self->transfer_done_callback_(self->transfer_done_callback_arg_);
+  }
+  return high_task_wakeup == pdTRUE;
 }
 
 void ST7032::SetDisplayControl(uint8_t setBit) {
@@ -1,18 +1,35 @@
 #ifndef BFOX_RECEIVER_MAIN_ST7032_H_
 #define BFOX_RECEIVER_MAIN_ST7032_H_
 
-#include <driver/i2c.h>
+#include <driver/i2c_master.h>
 #include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <string>
 
 namespace bfox_receiver_system {
 
+/// ST7032 character LCD.
+///
+/// Keeps a shadow copy of the visible DDRAM; Print/Printf/Write only send the
+/// cells that differ, each run of changed cells as one I2C transaction.
+/// Transfers are queued on an asynchronous i2c_master bus and return without
+/// waiting for the bus; the bus queue depth must be at least kTxSlotNum.
 class ST7032 {
  public:
   static constexpr uint8_t kI2cDefaultAddr = 0x3E;
+  static constexpr uint32_t kI2cStandardModeHz = 100000;
+  static constexpr uint32_t kI2cFastModeHz = 400000;
+  /// A RAM write takes 26.3us and the controller does not stretch SCL, so
+  /// each data byte (9 clocks) must take at least 27us on the bus
+  static constexpr uint32_t kI2cMaxDataHz = 9 * 1000000 / 27;  // 333kHz
+  static constexpr size_t kTxSlotNum = 16;  // transfers in flight
+  static constexpr uint8_t kMaxCols = 20;
+  static constexpr uint8_t kMaxLines = 4;
 
   static constexpr uint8_t kLcdClearDisplay = 0x01;
   static constexpr uint8_t kLcdReturnHome = 0x02;
@@ -81,11 +98,26 @@ class ST7032 {
   static constexpr uint8_t kLcdRab3_00 = 0x06;  // 1+(Rb/Ra)=3.00
   static constexpr uint8_t kLcdRab3_75 = 0x07;  // 1+(Rb/Ra)=3.75
 
+ public:
+  /// Called from the I2C ISR when every queued transfer has completed
+  using TransferDoneCallback = void (*)(void* arg);
+
  public:
   ST7032();
+  ~ST7032();
 
-  void Setup(i2c_port_t i2c_port, const uint8_t address, const uint8_t cols,
-             const uint8_t lines, const uint8_t charsize = kLcd5x8dots);
+  void Setup(i2c_master_bus_handle_t bus_handle, const uint8_t address,
+             const uint8_t cols, const uint8_t lines,
+             const uint8_t charsize = kLcd5x8dots,
+             const uint32_t scl_speed_hz = kI2cStandardModeHz);
+
+  /// Take over a controller already initialized by Setup and cleared, e.g.
+  /// kept powered over deep sleep. Sends nothing and skips the power-on
+  /// delays.
+  bool Attach(i2c_master_bus_handle_t bus_handle, const uint8_t address,
+              const uint8_t cols, const uint8_t lines,
+              const uint8_t charsize = kLcd5x8dots,
+              const uint32_t scl_speed_hz = kI2cStandardModeHz);
 
   void SetContrast(uint8_t cont);
   void Clear();
@@ -97,24 +129,71 @@ class ST7032 {
 
   void Write(const uint8_t* buffer, size_t size);
   void Write(const uint8_t value);
+  /// Write a 5x8 pattern (8 rows, 5 LSBs) into CGRAM code location (0-7)
+  void CreateChar(const uint8_t location, const uint8_t charmap[8]);
+
+  /// Raw instruction, not reflected in the shadow DDRAM
   void Command(const uint8_t value);
 
+  void SetTransferDoneCallback(TransferDoneCallback callback, void* arg);
+
+  /// Block until every queued transfer has completed
+  void WaitDone();
+
+  bool IsAttached() const { return dev_handle_ != nullptr; }
+
+  uint32_t GetTransactionCount() const { return transaction_count_; }
+  uint32_t GetErrorCount() const { return error_count_.load(); }
+  uint32_t GetTransferredBytes() const { return transferred_bytes_; }
+
  private:
   void SetDisplayControl(uint8_t setBit);
   void SetEntryMode(uint8_t setBit);
   void NormalFunctionSet();
   void ExtendFunctionSet();
 
+  void SetDdramAddress(const uint8_t address);
+  void WriteData(const uint8_t* data, const size_t size);
+  void Transmit(const uint8_t control, const uint8_t* data, const size_t size);
+
+  static bool OnTransDone(i2c_master_dev_handle_t dev_handle,
+                          const i2c_master_event_data_t* event_data,
+                          void* arg);
+
  private:
-  i2c_port_t i2c_port_;
-  uint8_t i2c_address_;
+  static constexpr int32_t kTransmitTimeoutMs = 1000;
+
+  // Unchanged cells resent to join two runs (cheaper than a new transaction)
+  static constexpr size_t kMaxRunGap = 4;
+  static constexpr uint8_t kInvalidAddress = 0xFF;
+
+  i2c_master_bus_handle_t bus_handle_;
+  i2c_master_dev_handle_t dev_handle_;
+
+  // Buffers stay untouched until the bus has sent them. Transfers complete
+  // in queue order, so slots are reused round robin.
+  uint8_t tx_slots_[kTxSlotNum][1 + kMaxCols];  // control byte + data
+  size_t next_tx_slot_;
+  SemaphoreHandle_t free_tx_slots_;  // given back by OnTransDone
+  std::atomic<uint32_t> pending_count_;
+  std::atomic<uint32_t> error_count_;
+  TransferDoneCallback transfer_done_callback_;
+  void* transfer_done_callback_arg_;
 
   uint8_t display_function_;
   uint8_t display_control_;
   uint8_t display_mode_;
 
   uint8_t num_lines_;
+  uint8_t num_cols_;
   uint8_t cur_line_;
+  uint8_t cur_col_;
+
+  uint8_t ddram_address_;  // LCD address counter, kInvalidAddress if unknown
+  uint8_t shadow_[kMaxLines][kMaxCols];  // characters shown on the LCD
+
+  uint32_t transaction_count_;
+  uint32_t transferred_bytes_;
 };
 
 using ST7032UniquePtr = std::unique_ptr<ST7032>;
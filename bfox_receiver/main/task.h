@@ -7,11 +7,19 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include <cstdint>
+#include <mutex>
 #include <string>
 
+#include "event_loop.h"
+
 namespace bfox_receiver_system {
 
 /// FreeRTOS xTask Wrap
+///
+/// The stack and TCB are supplied by the subclass (see StaticTask), so no
+/// task allocates from the heap. A task may instead run on an EventLoop
+/// (StartOn), sharing the loop task and its stack.
 class Task {
  public:
   enum class TaskStatus {
@@ -20,8 +28,6 @@ class Task {
     kEnd,
   };
 
-  static constexpr int32_t kTaskStackDepth = 8192;
-
   /// Task Priority
   static constexpr int32_t kPriorityTop = (configMAX_PRIORITIES)-1;
   static constexpr int32_t kPriorityLow = 0;
@@ -31,13 +37,29 @@ class Task {
  private:
   Task();
 
- public:
+ protected:
+  Task(const std::string& taskName, const int32_t priority, const int coreId,
+       StackType_t* const stack, const uint32_t stack_depth,
+       StaticTask_t* const task_buffer);
+
+  /// No stack of its own, started with StartOn only
   Task(const std::string& taskName, const int32_t priority, const int coreId);
+
+ public:
   virtual ~Task();
 
   /// Start Task
   void Start();
 
+  /// Run on loop instead: Initialize, then Update every update_interval_ms
+  /// (0: only when requested). Update must not block, and the task must
+  /// outlive the loop.
+  void StartOn(EventLoop* const loop, const uint32_t update_interval_ms);
+
+  /// StartOn tasks: run Update after delay_ms, then at the interval again.
+  /// Any task.
+  bool RequestUpdate(const uint32_t delay_ms);
+
   /// Stop Task
   void Stop();
 
@@ -47,6 +69,9 @@ class Task {
   /// (override) sub class processing
   virtual void Update() = 0;
 
+  /// Log the stack high-water mark of every running task
+  static void LogStackUsage();
+
  public:
   /// Task Running
   void Run();
@@ -54,6 +79,10 @@ class Task {
   /// Task Listener
   static void Listener(void* const pParam);
 
+ protected:
+  /// Loop given to StartOn, nullptr for a task of its own
+  EventLoop* GetEventLoop() const { return loop_; }
+
  protected:
   /// Task Status
   TaskStatus status_;
@@ -66,6 +95,46 @@ class Task {
 
   /// Use Core Id
   int32_t core_id_;
+
+ private:
+  StackType_t* stack_;
+  uint32_t stack_depth_;  // [byte]
+  StaticTask_t* task_buffer_;
+  TaskHandle_t handle_;
+
+  static void LoopStart(void* const arg);
+  static void LoopUpdate(void* const arg);
+
+  EventLoop* loop_;
+  EventLoop::Timer loop_timer_;
+  uint32_t update_interval_ms_;
+
+  // Registry of constructed tasks for LogStackUsage
+  static std::mutex registry_mutex_;
+  static Task* first_task_;
+  Task* next_task_;
+};
+
+/// Task whose stack and TCB are static storage of the subclass type, sized
+/// by Derived::kStackDepth [byte]. One instance per subclass.
+template <typename Derived>
+class StaticTask : public Task {
+ protected:
+  StaticTask(const std::string& taskName, const int32_t priority,
+             const int coreId)
+      : Task(taskName, priority, coreId, StackBuffer(), Derived::kStackDepth,
+             TaskBuffer()) {}
+
+ private:
+  static StackType_t* StackBuffer() {
+    alignas(16) static StackType_t stack[Derived::kStackDepth];
+    return stack;
+  }
+
+  static StaticTask_t* TaskBuffer() {
+    static StaticTask_t task_buffer;
+    return &task_buffer;
+  }
 };
 
 }  // namespace bfox_receiver_system